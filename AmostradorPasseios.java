@@ -0,0 +1,222 @@
+package leitura_interface;
+
+//// amostragem de sequencias por passeios aleatorios no EFG, para testes de fumaca em EFGs grandes
+//// cada thread tem o seu fluxo de numeros aleatorios (SplittableRandom.split a partir da semente) e o
+//// seu buffer; os buffers sao juntados na ordem das threads, entao a mesma semente e a mesma quantidade
+//// de threads geram sempre a mesma saida. Um erro numa thread e repassado por amostrar; amostragem
+//// interrompida ou com erro nao pode ser gravada.
+
+import java.io.IOException;
+import java.io.Writer;
+import java.util.Arrays;
+import java.util.LinkedList;
+import java.util.SplittableRandom;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+
+public class AmostradorPasseios {
+
+	private GrafoEFG grafo;
+	private long semente;
+	private int tamanho_passeio;
+	private politica_terminal politica;
+	private double[] pesos;
+	private double[] acumulado;
+	private int[] entradas;
+	private int[][] buffers;
+	private int[] usados;
+	private long[] passos_por_thread;
+	private long passos;
+	private long tempo;
+	private boolean concluido;
+
+	public AmostradorPasseios(GrafoEFG grafo, long semente) {
+		this.grafo = grafo;
+		this.semente = semente;
+		tamanho_passeio = 10;
+		politica = politica_terminal.parar;
+		pesos = new double[nome_componente.values().length];
+		Arrays.fill(pesos, 1.0);
+	}
+
+	//// o peso de uma aresta e o peso do tipo de componente do no de destino
+	public void setPeso(nome_componente tipo, double peso) {
+		pesos[tipo.ordinal()] = peso;
+	}
+
+	public void setTamanho_passeio(int tamanho_passeio) {
+		this.tamanho_passeio = tamanho_passeio;
+	}
+
+	public void setPolitica(politica_terminal politica) {
+		this.politica = politica;
+	}
+
+	private double peso(int v) {
+		return grafo.getTipo(v)==null ? 1.0 : pesos[grafo.getTipo(v).ordinal()];
+	}
+
+	// pesos acumulados por linha de adjacencia: a escolha do proximo no e uma busca binaria
+	private void preparar() {
+
+		acumulado = new double[grafo.quantidadeDestinos()];
+		for(int r=0;r<grafo.quantidadeLinhas();r++) {
+			double soma = 0;
+			for(int k=grafo.inicioLinha(r);k<grafo.fimLinha(r);k++) {
+				soma = soma + peso(grafo.destino(k));
+				acumulado[k] = soma;
+			}
+		}
+
+		int quantidade = 0;
+		for(int v=0;v<grafo.quantidadeNos();v++) {
+			if(grafo.isEntrada(v)) quantidade = quantidade + 1;
+		}
+		entradas = new int[quantidade];
+		int i = 0;
+		for(int v=0;v<grafo.quantidadeNos();v++) {
+			if(grafo.isEntrada(v)) {
+				entradas[i] = v;
+				i = i + 1;
+			}
+		}
+	}
+
+	public void amostrar(int passeios, int threads) {
+
+		concluido = false;
+		preparar();
+		buffers = new int[threads][];
+		usados = new int[threads];
+		passos_por_thread = new long[threads];
+		if(entradas.length==0) {
+			for(int t=0;t<threads;t++) buffers[t] = new int[0];
+			concluido = true;
+			return;
+		}
+
+		SplittableRandom mestre = new SplittableRandom(semente);
+		ExecutorService executor = Executors.newFixedThreadPool(threads);
+		long comeco = System.nanoTime();
+		try {
+			LinkedList<Future<?>> tarefas = new LinkedList<Future<?>>();
+			for(int t=0;t<threads;t++) {
+				final int id = t;
+				final SplittableRandom aleatorio = mestre.split();
+				final int quantidade = passeios/threads + (t<passeios%threads ? 1 : 0);
+				tarefas.add(executor.submit(() -> passear(id, aleatorio, quantidade)));
+			}
+			Interface.aguardar(tarefas);
+			concluido = !Thread.currentThread().isInterrupted();
+		} finally {
+			if(concluido) executor.shutdown();
+			else executor.shutdownNow();
+			tempo = System.nanoTime() - comeco;
+			passos = 0;
+			for(int t=0;t<threads;t++) {
+				passos = passos + passos_por_thread[t];
+			}
+		}
+	}
+
+	// cada passeio vai para o buffer da thread seguido de -1
+	private void passear(int id, SplittableRandom aleatorio, int quantidade) {
+
+		int[] buffer = new int[(int) Math.min(1<<24, Math.max(16L, (long) quantidade*(tamanho_passeio+1)))];
+		int tamanho = 0;
+
+		for(int p=0;p<quantidade;p++) {
+			if(Thread.currentThread().isInterrupted()) return;
+			int atual = entradas[aleatorio.nextInt(entradas.length)];
+			for(int passo=0;passo<tamanho_passeio;passo++) {
+				if(tamanho+2>buffer.length) buffer = crescer(buffer, tamanho+2);
+				buffer[tamanho] = atual;
+				tamanho = tamanho + 1;
+				if(passo==tamanho_passeio-1) break;
+
+				if(grafo.isTerminal(atual) || grafo.grau(atual)==0) {
+					if(politica==politica_terminal.parar) break;
+					atual = entradas[aleatorio.nextInt(entradas.length)];
+					continue;
+				}
+				atual = escolher(atual, aleatorio);
+			}
+			if(tamanho+1>buffer.length) buffer = crescer(buffer, tamanho+1);
+			buffer[tamanho] = -1;
+			tamanho = tamanho + 1;
+		}
+
+		buffers[id] = buffer;
+		usados[id] = tamanho;
+		passos_por_thread[id] = tamanho - quantidade;
+	}
+
+	private static final int TAMANHO_MAXIMO_BUFFER = Integer.MAX_VALUE - 8;
+
+	// dobra o buffer sem passar do maior vetor que a JVM aloca (2*length estoura int depois de 2^30)
+	private static int[] crescer(int[] buffer, int minimo) {
+		if(minimo>TAMANHO_MAXIMO_BUFFER || minimo<0) {
+			throw new IllegalStateException("passeios de uma thread passam de "+TAMANHO_MAXIMO_BUFFER+" posicoes: use mais threads ou menos passeios");
+		}
+		long novo = Math.max(2L*buffer.length, minimo);
+		return Arrays.copyOf(buffer, (int) Math.min(novo, TAMANHO_MAXIMO_BUFFER));
+	}
+
+	private int escolher(int v, SplittableRandom aleatorio) {
+		int linha = grafo.getLinha(v);
+		int de = grafo.inicioLinha(linha);
+		int ate = grafo.fimLinha(linha);
+		double total = acumulado[ate-1];
+		if(total<=0) return grafo.destino(de + aleatorio.nextInt(ate-de));
+
+		double sorteio = aleatorio.nextDouble()*total;
+		int posicao = Arrays.binarySearch(acumulado, de, ate, sorteio);
+		if(posicao<0) posicao = -posicao-1;
+		// pula destinos com peso zero (mesmo acumulado do anterior)
+		while(posicao<ate-1 && acumulado[posicao]<=sorteio) posicao = posicao + 1;
+		return grafo.destino(posicao);
+	}
+
+	public long gravar(String caminho_arquivo) throws IOException {
+
+		if(!concluido) throw new IllegalStateException("amostragem nao concluida: chame amostrar antes de gravar");
+		Writer saida = ArquivoSaida.abrirTexto(caminho_arquivo);
+		long quantidade = 0;
+		boolean inicio_linha = true;
+		try {
+			for(int t=0;t<buffers.length;t++) {
+				int[] buffer = buffers[t];
+				for(int i=0;i<usados[t];i++) {
+					if(buffer[i]<0) {
+						saida.write("\n");
+						inicio_linha = true;
+						quantidade = quantidade + 1;
+						continue;
+					}
+					if(!inicio_linha) saida.write(", ");
+					saida.write(grafo.getNome(buffer[i]));
+					inicio_linha = false;
+				}
+			}
+		} finally {
+			saida.close();
+		}
+		return quantidade;
+	}
+
+	public long getPassos() {
+		return passos;
+	}
+
+	public String getRelatorio() {
+		StringBuilder relatorio = new StringBuilder();
+		for(int t=0;t<passos_por_thread.length;t++) {
+			relatorio.append(String.format("passeio-%d: %d passos%n", t, passos_por_thread[t]));
+		}
+		double segundos = tempo/1e9;
+		relatorio.append(String.format("%d passos em %.3f s (%.0f passos/s)%n", passos, segundos, segundos>0 ? passos/segundos : 0.0));
+		return relatorio.toString();
+	}
+
+}
@@ -0,0 +1,344 @@
+package leitura_interface;
+
+//// componentes de uma janela guardados em vetores paralelos (struct of arrays): id do nome, ordinal de
+//// nome_componente, ordinal de tipo_no, id da funcao (slot), linha do .ui e container, um indice por componente.
+//// Cada Componente e so uma visao (armazem, indice) sobre estes vetores, e as arestas de saida de cada
+//// indice ficam num int[] de indices do mesmo armazem, seguido opcionalmente de uma cauda compartilhada:
+//// a clique dos nos medio de um grupo de containers e uma cauda so, e nao uma copia por no.
+//// Um Componente recem criado guarda os campos num objeto avulso ate Window.add_componente o adotar
+//// no armazem da janela. Aresta para um componente que ainda nao esta no armazem fica pendente
+//// (codificada como -(k+1)) e vira indice quando ele for adotado, sem mudar a ordem das saidas.
+
+import java.util.AbstractList;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.IdentityHashMap;
+import java.util.LinkedList;
+import java.util.List;
+
+public class ArmazemComponentes {
+
+	private static final nome_componente[] TIPOS = nome_componente.values();
+	private static final tipo_no[] TIPOS_NO = tipo_no.values();
+	private static final byte SEM_TIPO = -1;
+
+	private int quantidade;
+	private Componente[] visoes;
+	private int[] id_nome;
+	private byte[] tipos;
+	private byte[] tipos_no;
+	private int[] id_funcao;
+	private int[] linha_fonte;
+	private Container[] containers;
+	private int[][] saidas;
+	private int[] grau;
+	private int[] cauda;
+	private int[][] caudas;
+	private int[] grau_caudas;
+	private int quantidade_caudas;
+	private HashMap<Integer, LinkedList<String>> dialogos;
+	private ArrayList<Componente> pendentes;
+	private IdentityHashMap<Componente, ArrayList<Long>> esperando;
+	private int[] ids_qualificados;
+	private String prefixo_qualificado;
+	private int geracao_qualificados;
+	private static final int SEM_ID_QUALIFICADO = -2;
+
+	public ArmazemComponentes() {
+		this(16);
+	}
+
+	public ArmazemComponentes(int capacidade) {
+		capacidade = Math.max(capacidade, 1);
+		visoes = new Componente[capacidade];
+		id_nome = new int[capacidade];
+		tipos = new byte[capacidade];
+		tipos_no = new byte[capacidade];
+		id_funcao = new int[capacidade];
+		linha_fonte = new int[capacidade];
+		containers = new Container[capacidade];
+		saidas = new int[capacidade][];
+		grau = new int[capacidade];
+		cauda = new int[capacidade];
+		caudas = new int[4][];
+		grau_caudas = new int[4];
+	}
+
+	//// reserva um indice para a visao, com os campos vazios
+	int novo(Componente visao) {
+		if(quantidade==visoes.length) crescer(2*visoes.length);
+		int i = quantidade;
+		visoes[i] = visao;
+		id_nome[i] = TabelaSimbolos.NENHUM;
+		id_funcao[i] = TabelaSimbolos.NENHUM;
+		tipos[i] = SEM_TIPO;
+		tipos_no[i] = SEM_TIPO;
+		cauda[i] = -1;
+		quantidade = quantidade + 1;
+		return i;
+	}
+
+	private void crescer(int capacidade) {
+		visoes = Arrays.copyOf(visoes, capacidade);
+		id_nome = Arrays.copyOf(id_nome, capacidade);
+		tipos = Arrays.copyOf(tipos, capacidade);
+		tipos_no = Arrays.copyOf(tipos_no, capacidade);
+		id_funcao = Arrays.copyOf(id_funcao, capacidade);
+		linha_fonte = Arrays.copyOf(linha_fonte, capacidade);
+		containers = Arrays.copyOf(containers, capacidade);
+		saidas = Arrays.copyOf(saidas, capacidade);
+		grau = Arrays.copyOf(grau, capacidade);
+		cauda = Arrays.copyOf(cauda, capacidade);
+	}
+
+	//// traz o componente (e suas arestas) para este armazem e devolve o novo indice;
+	//// o componente pode estar avulso ou em outro armazem
+	public int adotar(Componente componente) {
+
+		if(componente.getArmazem()==this) return componente.getIndice();
+
+		int novo = novo(componente);
+		id_nome[novo] = componente.getId_nome();
+		setTipo(novo, componente.getTipo());
+		setTipo_no(novo, componente.getTipo_no());
+		id_funcao[novo] = componente.getId_funcao();
+		linha_fonte[novo] = componente.getLinha_fonte();
+		containers[novo] = componente.getContainer();
+		LinkedList<String> lista = componente.getDialogos_invocados();
+		if(!lista.isEmpty()) {
+			if(dialogos==null) dialogos = new HashMap<Integer, LinkedList<String>>();
+			dialogos.put(novo, lista);
+		}
+		// copia as saidas antes de a visao passar a apontar para ca, assim um laco vira indice local
+		ArrayList<Componente> saidas_antigas = new ArrayList<Componente>(componente.getNos_que_saem());
+		componente.mover(this, novo);
+		for(Componente destino : saidas_antigas) {
+			ligar(novo, destino);
+		}
+
+		// arestas deste armazem que esperavam pelo componente
+		if(esperando!=null) {
+			ArrayList<Long> posicoes = esperando.remove(componente);
+			if(posicoes!=null) {
+				for(long p : posicoes) {
+					saidas[(int) (p>>>32)][(int) p] = novo;
+				}
+			}
+		}
+		return novo;
+	}
+
+	//// aresta indice -> destino, no fim da lista de saida de indice
+	public void ligar(int indice, Componente destino) {
+		if(cauda[indice]>=0) copiarCauda(indice);
+		int d;
+		if(destino.getArmazem()==this) {
+			d = destino.getIndice();
+		} else {
+			if(pendentes==null) {
+				pendentes = new ArrayList<Componente>();
+				esperando = new IdentityHashMap<Componente, ArrayList<Long>>();
+			}
+			d = -(pendentes.size()+1);
+			pendentes.add(destino);
+			ArrayList<Long> posicoes = esperando.get(destino);
+			if(posicoes==null) {
+				posicoes = new ArrayList<Long>();
+				esperando.put(destino, posicoes);
+			}
+			posicoes.add(((long) indice<<32) | grau[indice]);
+		}
+		empilhar(indice, d);
+	}
+
+	private void empilhar(int indice, int d) {
+		if(saidas[indice]==null) saidas[indice] = new int[4];
+		else if(grau[indice]==saidas[indice].length) saidas[indice] = Arrays.copyOf(saidas[indice], 2*grau[indice]);
+		saidas[indice][grau[indice]] = d;
+		grau[indice] = grau[indice] + 1;
+	}
+
+	//// nova cauda vazia; uma cauda e uma lista de destinos deste armazem que varios indices podem usar
+	public int novaCauda() {
+		if(quantidade_caudas==caudas.length) {
+			caudas = Arrays.copyOf(caudas, 2*caudas.length);
+			grau_caudas = Arrays.copyOf(grau_caudas, 2*grau_caudas.length);
+		}
+		caudas[quantidade_caudas] = new int[4];
+		quantidade_caudas = quantidade_caudas + 1;
+		return quantidade_caudas-1;
+	}
+
+	//// aresta para destino no fim da cauda c, vista por todos os indices que usam c
+	public void ligarCauda(int c, Componente destino) {
+		if(destino.getArmazem()!=this) throw new IllegalArgumentException("cauda so liga componentes do mesmo armazem");
+		if(grau_caudas[c]==caudas[c].length) caudas[c] = Arrays.copyOf(caudas[c], 2*grau_caudas[c]);
+		caudas[c][grau_caudas[c]] = destino.getIndice();
+		grau_caudas[c] = grau_caudas[c] + 1;
+	}
+
+	//// as saidas de indice passam a terminar com a cauda c (sem copia)
+	public void usarCauda(int indice, int c) {
+		if(cauda[indice]>=0) copiarCauda(indice);
+		cauda[indice] = c;
+	}
+
+	// um ligar depois da cauda mantem a ordem das saidas: a cauda vira parte propria do indice
+	private void copiarCauda(int indice) {
+		int c = cauda[indice];
+		cauda[indice] = -1;
+		for(int k=0;k<grau_caudas[c];k++) {
+			empilhar(indice, caudas[c][k]);
+		}
+	}
+
+	//// cauda usada por indice, -1 se nao usa nenhuma
+	public int getCauda(int indice) {
+		return cauda[indice];
+	}
+
+	//// saidas proprias de indice, antes da cauda
+	public int grauProprio(int indice) {
+		return grau[indice];
+	}
+
+	private Componente componente(int d) {
+		return d>=0 ? visoes[d] : pendentes.get(-d-1);
+	}
+
+	public int quantidade() {
+		return quantidade;
+	}
+
+	public Componente getComponente(int indice) {
+		return visoes[indice];
+	}
+
+	//// visao somente leitura dos componentes, na ordem em que foram adotados
+	public List<Componente> getComponentes() {
+		return new AbstractList<Componente>() {
+			@Override
+			public Componente get(int indice) {
+				if(indice>=quantidade) throw new IndexOutOfBoundsException("indice: "+indice);
+				return visoes[indice];
+			}
+
+			@Override
+			public int size() {
+				return quantidade;
+			}
+		};
+	}
+
+	public int grau(int indice) {
+		return cauda[indice]<0 ? grau[indice] : grau[indice] + grau_caudas[cauda[indice]];
+	}
+
+	//// k-esimo destino de indice, como indice deste armazem (negativo se ainda pendente)
+	public int destino(int indice, int k) {
+		return k<grau[indice] ? saidas[indice][k] : caudas[cauda[indice]][k-grau[indice]];
+	}
+
+	//// visao somente leitura das saidas de indice
+	public List<Componente> getSaidas(final int indice) {
+		return new AbstractList<Componente>() {
+			@Override
+			public Componente get(int k) {
+				if(k>=grau(indice)) throw new IndexOutOfBoundsException("saida: "+k);
+				return componente(destino(indice, k));
+			}
+
+			@Override
+			public int size() {
+				return grau(indice);
+			}
+		};
+	}
+
+	public int getId_nome(int indice) {
+		return id_nome[indice];
+	}
+
+	public void setId_nome(int indice, int id) {
+		id_nome[indice] = id;
+		if(ids_qualificados!=null && indice<ids_qualificados.length) ids_qualificados[indice] = SEM_ID_QUALIFICADO;
+	}
+
+	//// id de "<prefixo>_<nome>" (o nome qualificado pela janela, quando um grafo junta varias janelas);
+	//// cada nome e internado uma vez e guardado, entao renderizar de novo nao cria nem procura simbolos
+	public synchronized int getId_qualificado(int indice, String prefixo) {
+		TabelaSimbolos simbolos = TabelaSimbolos.getInstance();
+		if(ids_qualificados==null || !prefixo.equals(prefixo_qualificado) || geracao_qualificados!=simbolos.geracao()) {
+			ids_qualificados = new int[quantidade];
+			Arrays.fill(ids_qualificados, SEM_ID_QUALIFICADO);
+			prefixo_qualificado = prefixo;
+			geracao_qualificados = simbolos.geracao();
+		} else if(indice>=ids_qualificados.length) {
+			int antigo = ids_qualificados.length;
+			ids_qualificados = Arrays.copyOf(ids_qualificados, quantidade);
+			Arrays.fill(ids_qualificados, antigo, quantidade, SEM_ID_QUALIFICADO);
+		}
+		if(ids_qualificados[indice]==SEM_ID_QUALIFICADO) {
+			ids_qualificados[indice] = simbolos.id(prefixo+"_"+simbolos.nome(id_nome[indice]));
+		}
+		return ids_qualificados[indice];
+	}
+
+	public int getId_funcao(int indice) {
+		return id_funcao[indice];
+	}
+
+	public void setId_funcao(int indice, int id) {
+		id_funcao[indice] = id;
+	}
+
+	public nome_componente getTipo(int indice) {
+		return tipos[indice]==SEM_TIPO ? null : TIPOS[tipos[indice]];
+	}
+
+	public void setTipo(int indice, nome_componente tipo) {
+		tipos[indice] = tipo==null ? SEM_TIPO : (byte) tipo.ordinal();
+	}
+
+	public tipo_no getTipo_no(int indice) {
+		return tipos_no[indice]==SEM_TIPO ? null : TIPOS_NO[tipos_no[indice]];
+	}
+
+	public void setTipo_no(int indice, tipo_no tipo) {
+		tipos_no[indice] = tipo==null ? SEM_TIPO : (byte) tipo.ordinal();
+	}
+
+	public int getLinha_fonte(int indice) {
+		return linha_fonte[indice];
+	}
+
+	public void setLinha_fonte(int indice, int linha) {
+		linha_fonte[indice] = linha;
+	}
+
+	public Container getContainer(int indice) {
+		return containers[indice];
+	}
+
+	public void setContainer(int indice, Container container) {
+		containers[indice] = container;
+	}
+
+	//// poucos componentes invocam dialogos, entao as listas ficam num mapa esparso
+	public LinkedList<String> getDialogos(int indice) {
+		LinkedList<String> lista = dialogos==null ? null : dialogos.get(indice);
+		return lista==null ? new LinkedList<String>() : lista;
+	}
+
+	public void addDialogo(int indice, String dialogo) {
+		if(dialogos==null) dialogos = new HashMap<Integer, LinkedList<String>>();
+		LinkedList<String> lista = dialogos.get(indice);
+		if(lista==null) {
+			lista = new LinkedList<String>();
+			dialogos.put(indice, lista);
+		}
+		lista.add(dialogo);
+	}
+
+}
@@ -0,0 +1,102 @@
+package leitura_interface;
+
+//// armazem em disco dos EFGs ja traduzidos de cada dialogo
+//// a chave e o hash (SHA-256) do conteudo do .ui e do .cpp: alterar qualquer um deles gera outra entrada
+
+import java.io.BufferedOutputStream;
+import java.io.DataOutputStream;
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.RandomAccessFile;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.file.Files;
+import java.nio.file.StandardCopyOption;
+import java.security.MessageDigest;
+import java.security.NoSuchAlgorithmException;
+
+public class ArmazemFragmentos {
+
+	private static final int ASSINATURA = 0x45464746; // "EFGF"
+	private static final int VERSAO = 3;
+
+	private File pasta;
+
+	public ArmazemFragmentos(String caminho_pasta) {
+		pasta = new File(caminho_pasta);
+		pasta.mkdirs();
+	}
+
+	public String chave(String caminho_ui, String caminho_cpp) throws IOException {
+		try {
+			MessageDigest hash = MessageDigest.getInstance("SHA-256");
+			hash.update(Files.readAllBytes(new File(caminho_ui).toPath()));
+			hash.update((byte) 0);
+			hash.update(Files.readAllBytes(new File(caminho_cpp).toPath()));
+
+			StringBuilder chave = new StringBuilder();
+			for(byte b : hash.digest()) {
+				chave.append(String.format("%02x", b));
+			}
+			return chave.toString();
+		} catch (NoSuchAlgorithmException e) {
+			throw new IOException(e);
+		}
+	}
+
+	//// fragmento gravado para a chave, ou null se ainda nao existe (ou e de outra versao, ou esta truncado/corrompido)
+	public GrafoEFG ler(String chave) {
+
+		File arquivo = new File(pasta, chave+".efg");
+		if(!arquivo.isFile()) return null;
+
+		try {
+			RandomAccessFile arq = new RandomAccessFile(arquivo, "r");
+			FileChannel canal = arq.getChannel();
+			MappedByteBuffer dados = canal.map(FileChannel.MapMode.READ_ONLY, 0, canal.size());
+			arq.close();
+
+			if(dados.getInt()!=ASSINATURA || dados.getInt()!=VERSAO) return null;
+			return new GrafoEFG(dados);
+
+		} catch (IOException e) {
+			System.err.printf("Erro na abertura do arquivo: %s.\n Classe: ArmazemFragmentos metodo: ler()",
+					e.getMessage());
+			return null;
+		} catch (RuntimeException e) {
+			// BufferUnderflowException, NegativeArraySizeException, ... de um fragmento truncado: e so retraduzir
+			System.err.printf("Fragmento invalido: %s (%s).\n Classe: ArmazemFragmentos metodo: ler()",
+					arquivo.getName(), e);
+			return null;
+		}
+	}
+
+	public void gravar(String chave, GrafoEFG grafo) {
+
+		File arquivo = new File(pasta, chave+".efg");
+		File temporario = null;
+		try {
+			// grava em um temporario e renomeia: leitores concorrentes nunca veem um fragmento pela metade
+			temporario = File.createTempFile(chave, ".tmp", pasta);
+			DataOutputStream saida = new DataOutputStream(new BufferedOutputStream(new FileOutputStream(temporario)));
+			try {
+				saida.writeInt(ASSINATURA);
+				saida.writeInt(VERSAO);
+				grafo.gravar(saida);
+			} finally {
+				saida.close();
+			}
+			Files.move(temporario.toPath(), arquivo.toPath(), StandardCopyOption.REPLACE_EXISTING, StandardCopyOption.ATOMIC_MOVE);
+			temporario = null;
+
+		} catch (IOException e) {
+			System.err.printf("Erro na gravacao do arquivo: %s.\n Classe: ArmazemFragmentos metodo: gravar()",
+					e.getMessage());
+		} finally {
+			// o temporario so sobra se a gravacao ou a troca falhou
+			if(temporario!=null) temporario.delete();
+		}
+	}
+
+}
@@ -0,0 +1,42 @@
+package leitura_interface;
+
+//// abre os arquivos de saida dos exportadores de texto; caminhos terminados em .gz sao comprimidos
+//// com gzip enquanto o texto e escrito (o JDK nao tem zstd e o projeto nao tem outras dependencias)
+
+import java.io.BufferedOutputStream;
+import java.io.BufferedWriter;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.io.OutputStreamWriter;
+import java.io.Writer;
+import java.nio.charset.Charset;
+import java.nio.charset.StandardCharsets;
+import java.util.zip.GZIPOutputStream;
+
+public class ArquivoSaida {
+
+	private static final int TAMANHO_BUFFER = 1<<16;
+
+	public static boolean isComprimido(String caminho_arquivo) {
+		return caminho_arquivo.endsWith(".gz");
+	}
+
+	public static OutputStream abrir(String caminho_arquivo) throws IOException {
+		OutputStream arquivo = new FileOutputStream(caminho_arquivo);
+		if(isComprimido(caminho_arquivo)) {
+			return new BufferedOutputStream(new GZIPOutputStream(arquivo, TAMANHO_BUFFER), TAMANHO_BUFFER);
+		}
+		return new BufferedOutputStream(arquivo, TAMANHO_BUFFER);
+	}
+
+	//// sempre UTF-8, como o ExportadorDotParalelo: a saida nao depende da codificacao padrao da plataforma
+	public static Writer abrirTexto(String caminho_arquivo) throws IOException {
+		return abrirTexto(caminho_arquivo, StandardCharsets.UTF_8);
+	}
+
+	public static Writer abrirTexto(String caminho_arquivo, Charset codificacao) throws IOException {
+		return new BufferedWriter(new OutputStreamWriter(abrir(caminho_arquivo), codificacao));
+	}
+
+}
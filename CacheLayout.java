@@ -0,0 +1,162 @@
+package leitura_interface;
+
+//// reaproveita o layout de uma renderizacao anterior
+//// as posicoes dos nos vem da saida -Tplain (polegadas) e ficam gravadas em um arquivo .plain.
+//// Na proxima renderizacao:
+////   todos os nos tem posicao: nao ha layout, o grafo vai direto para o motor nop (neato -n) com pos em pontos
+////   alguns nos sao novos:    neato com os nos conhecidos fixos (pos="x,y!" em polegadas) posiciona so os novos,
+////                            o resultado atualiza o cache e a imagem sai pelo nop
+////   cache vazio:             layout normal com o motor da politica, que passa a ser o cache
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.File;
+import java.io.IOException;
+import java.io.Writer;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.Locale;
+import java.util.zip.GZIPInputStream;
+
+public class CacheLayout {
+
+	private String caminho_arquivo;
+	private HashMap<String, double[]> posicoes;
+
+	public CacheLayout(String caminho_arquivo) {
+		this.caminho_arquivo = caminho_arquivo;
+		posicoes = new HashMap<String, double[]>();
+		if(new File(caminho_arquivo).exists()) {
+			try {
+				byte[] bytes = Files.readAllBytes(Paths.get(caminho_arquivo));
+				if(ArquivoSaida.isComprimido(caminho_arquivo)) bytes = descomprimir(bytes);
+				lerPlain(new String(bytes, StandardCharsets.UTF_8));
+			} catch (IOException e) {
+				System.err.printf("Erro na abertura do arquivo: %s.\n Classe: CacheLayout metodo: CacheLayout()", e.getMessage());
+			}
+		}
+	}
+
+	// o cache e gravado por ArquivoSaida.abrirTexto, que comprime os caminhos .gz
+	private static byte[] descomprimir(byte[] bytes) throws IOException {
+		GZIPInputStream entrada = new GZIPInputStream(new ByteArrayInputStream(bytes));
+		try {
+			ByteArrayOutputStream saida = new ByteArrayOutputStream();
+			byte[] buffer = new byte[1<<16];
+			int lidos;
+			while((lidos = entrada.read(buffer))!=-1) {
+				saida.write(buffer, 0, lidos);
+			}
+			return saida.toByteArray();
+		} finally {
+			entrada.close();
+		}
+	}
+
+	//// le as linhas "graph escala largura altura" e "node nome x y ..." da saida -Tplain
+	public void lerPlain(String plain) {
+		posicoes.clear();
+		double escala = 1;
+		for(String linha : plain.split("\n")) {
+			ArrayList<String> partes = separar(linha);
+			if(partes.size()<4) continue;
+			if(partes.get(0).equals("graph")) {
+				escala = Double.parseDouble(partes.get(1));
+			}
+			else if(partes.get(0).equals("node")) {
+				posicoes.put(partes.get(1), new double[] {escala*Double.parseDouble(partes.get(2)), escala*Double.parseDouble(partes.get(3))});
+			}
+		}
+	}
+
+	// separa por espacos, respeitando nomes entre aspas
+	private static ArrayList<String> separar(String linha) {
+		ArrayList<String> partes = new ArrayList<String>();
+		StringBuilder atual = new StringBuilder();
+		boolean aspas = false;
+		boolean tem_parte = false;
+		for(int i=0;i<linha.length();i++) {
+			char c = linha.charAt(i);
+			if(aspas) {
+				if(c=='\\' && i+1<linha.length()) {
+					i = i + 1;
+					atual.append(linha.charAt(i));
+				}
+				else if(c=='"') aspas = false;
+				else atual.append(c);
+			}
+			else if(c=='"') {
+				aspas = true;
+				tem_parte = true;
+			}
+			else if(Character.isWhitespace(c)) {
+				if(tem_parte) partes.add(atual.toString());
+				atual.setLength(0);
+				tem_parte = false;
+			}
+			else {
+				atual.append(c);
+				tem_parte = true;
+			}
+		}
+		if(tem_parte) partes.add(atual.toString());
+		return partes;
+	}
+
+	public byte[] renderizar(GraphViz gv, GrafoEFG grafo, String dot, String motor, String tipo) {
+
+		int fixos = 0;
+		for(int v=0;v<grafo.quantidadeNos();v++) {
+			if(posicoes.containsKey(grafo.getNome(v))) fixos = fixos + 1;
+		}
+
+		if(fixos<grafo.quantidadeNos() || fixos==0) {
+			gv.setLayout(fixos>0 ? "neato" : motor);
+			byte[] plain = gv.getGraph(fixar(grafo, dot, false), "plain");
+			if(plain==null) return null;
+			String texto = new String(plain, StandardCharsets.UTF_8);
+			lerPlain(texto);
+			gravar(texto);
+		}
+
+		gv.setLayout("nop");
+		return gv.getGraph(fixar(grafo, dot, true), tipo);
+	}
+
+	//// acrescenta ao DOT a posicao fixa dos nos conhecidos, em pontos (nop) ou em polegadas (neato)
+	public String fixar(GrafoEFG grafo, String dot, boolean em_pontos) {
+
+		double fator = em_pontos ? 72 : 1;
+		StringBuilder fixacoes = new StringBuilder();
+		for(int v=0;v<grafo.quantidadeNos();v++) {
+			double[] posicao = posicoes.get(grafo.getNome(v));
+			if(posicao==null) continue;
+			fixacoes.append(String.format(Locale.ROOT, "\t%s [pos=\"%.4f,%.4f!\"];\n", grafo.getNome(v), fator*posicao[0], fator*posicao[1]));
+		}
+
+		int fim = dot.lastIndexOf('}');
+		if(fim<0) return dot + fixacoes;
+		return dot.substring(0, fim) + fixacoes + dot.substring(fim);
+	}
+
+	private void gravar(String plain) {
+		try {
+			Writer saida = ArquivoSaida.abrirTexto(caminho_arquivo);
+			try {
+				saida.write(plain);
+			} finally {
+				saida.close();
+			}
+		} catch (IOException e) {
+			System.err.printf("Erro na abertura do arquivo: %s.\n Classe: CacheLayout metodo: gravar()", e.getMessage());
+		}
+	}
+
+	public int quantidadePosicoes() {
+		return posicoes.size();
+	}
+
+}
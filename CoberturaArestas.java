@@ -0,0 +1,266 @@
+package leitura_interface;
+
+//// conjunto de sequencias que cobre cada aresta do EFG pelo menos uma vez (aproximacao gulosa do
+//// carteiro chines): cada sequencia comeca em um no de entrada, segue por arestas ainda nao cobertas
+//// e, quando fica sem elas, anda pelo caminho mais curto ate a proxima aresta pendente ou ate um terminal.
+////
+//// as arestas nao viram objetos: a aresta i do no v e o bit base[v]+i de um BitSet, e as buscas em
+//// largura percorrem cada linha de adjacencia compartilhada uma unica vez (a clique de nos medio de
+//// um container e visitada uma vez por busca, e nao uma vez por no). A volta ao terminal usa as
+//// distancias de TabelasDistancia.
+////
+//// tamanho_maximo limita a parte de cada sequencia que procura arestas pendentes; o trecho final ate
+//// o terminal mais proximo e sempre acrescentado.
+
+import java.io.IOException;
+import java.io.Writer;
+import java.util.ArrayList;
+import java.util.BitSet;
+
+public class CoberturaArestas {
+
+	private GrafoEFG grafo;
+	private int tamanho_maximo;
+	private int[] base;
+	// um unico BitSet para todas as arestas: a aresta i do no v e o bit base[v]+i
+	private BitSet cobertas;
+	private int[] cursor_medio;
+	private int[] cursor_terminal;
+	private TabelasDistancia tabelas;
+	private long pendentes;
+	private long inalcancaveis;
+	private ArrayList<int[]> sequencias;
+
+	// estado das buscas em largura
+	private int[] pai;
+	private int[] visitado;
+	private int[] linha_visitada;
+	private int[] fila;
+	private int geracao;
+
+	public CoberturaArestas(GrafoEFG grafo, int tamanho_maximo) {
+		this.grafo = grafo;
+		this.tamanho_maximo = tamanho_maximo;
+		gerar();
+	}
+
+	private void gerar() {
+
+		int n = grafo.quantidadeNos();
+		base = new int[n+1];
+		for(int v=0;v<n;v++) {
+			long proxima = (long) base[v] + grafo.grau(v);
+			if(proxima>Integer.MAX_VALUE) throw new IllegalStateException("EFG com arestas demais para a cobertura: "+grafo.quantidadeArestas());
+			base[v+1] = (int) proxima;
+		}
+		cobertas = new BitSet(base[n]);
+		cursor_medio = new int[n];
+		cursor_terminal = new int[n];
+		pai = new int[n];
+		visitado = new int[n];
+		linha_visitada = new int[grafo.quantidadeLinhas()];
+		fila = new int[n];
+		geracao = 0;
+		tabelas = new TabelasDistancia(grafo);
+		sequencias = new ArrayList<int[]>();
+
+		// so as arestas que saem de nos alcancaveis (e que nao sao terminais) podem ser cobertas
+		int[] entradas = entradas();
+		buscar(entradas, false);
+		pendentes = 0;
+		for(int v=0;v<n;v++) {
+			if(visitado[v]==geracao) pendentes = pendentes + grau(v);
+		}
+		inalcancaveis = base[n] - pendentes;
+
+		while(pendentes>0) {
+			int alvo = buscar(entradas, true);
+			if(alvo<0) break;
+			sequencias.add(construirSequencia(caminho(alvo)));
+		}
+	}
+
+	private int[] construirSequencia(ArrayList<Integer> inicio) {
+
+		ArrayList<Integer> sequencia = new ArrayList<Integer>();
+		adicionar(sequencia, inicio);
+		int atual = sequencia.get(sequencia.size()-1);
+
+		// a primeira aresta pendente e sempre coberta, mesmo se o caminho ate ela ja passou do tamanho maximo
+		boolean primeira = true;
+		while(!grafo.isTerminal(atual) && (primeira || sequencia.size()<tamanho_maximo)) {
+
+			int i = proximaPendente(atual);
+			if(i>=0) {
+				primeira = false;
+				cobrir(atual, i);
+				atual = grafo.vizinho(atual, i);
+				sequencia.add(atual);
+				continue;
+			}
+
+			int alvo = buscar(new int[] {atual}, true);
+			if(alvo<0 || sequencia.size()-1+profundidade(alvo)>=tamanho_maximo) break;
+			ArrayList<Integer> trecho = caminho(alvo);
+			trecho.remove(0);
+			adicionar(sequencia, trecho);
+			atual = alvo;
+		}
+
+		// termina pelo caminho mais curto ate um terminal
+		while(!grafo.isTerminal(atual) && tabelas.getDistanciaTerminal(atual)>=0) {
+			int proximo = -1;
+			for(int i=0;i<grafo.grau(atual) && proximo<0;i++) {
+				if(tabelas.getDistanciaTerminal(grafo.vizinho(atual, i))==tabelas.getDistanciaTerminal(atual)-1) {
+					proximo = i;
+				}
+			}
+			if(proximo<0) break;
+			if(cobertas.get(base[atual]+proximo)==false) cobrir(atual, proximo);
+			atual = grafo.vizinho(atual, proximo);
+			sequencia.add(atual);
+		}
+
+		int[] resultado = new int[sequencia.size()];
+		for(int i=0;i<resultado.length;i++) {
+			resultado[i] = sequencia.get(i);
+		}
+		return resultado;
+	}
+
+	// anda pelo trecho marcando como cobertas as arestas ainda pendentes
+	private void adicionar(ArrayList<Integer> sequencia, ArrayList<Integer> trecho) {
+		for(int no : trecho) {
+			if(!sequencia.isEmpty()) {
+				int anterior = sequencia.get(sequencia.size()-1);
+				for(int i=0;i<grafo.grau(anterior);i++) {
+					if(grafo.vizinho(anterior, i)==no) {
+						if(cobertas.get(base[anterior]+i)==false) cobrir(anterior, i);
+						break;
+					}
+				}
+			}
+			sequencia.add(no);
+		}
+	}
+
+	private void cobrir(int v, int i) {
+		cobertas.set(base[v]+i);
+		pendentes = pendentes - 1;
+	}
+
+	// proxima aresta pendente de v, preferindo as que nao encerram a sequencia
+	private int proximaPendente(int v) {
+		while(cursor_medio[v]<grau(v) && (cobertas.get(base[v]+cursor_medio[v]) || grafo.isTerminal(grafo.vizinho(v, cursor_medio[v])))) {
+			cursor_medio[v] = cursor_medio[v] + 1;
+		}
+		if(cursor_medio[v]<grau(v)) return cursor_medio[v];
+
+		while(cursor_terminal[v]<grau(v) && (cobertas.get(base[v]+cursor_terminal[v]) || !grafo.isTerminal(grafo.vizinho(v, cursor_terminal[v])))) {
+			cursor_terminal[v] = cursor_terminal[v] + 1;
+		}
+		if(cursor_terminal[v]<grau(v)) return cursor_terminal[v];
+		return -1;
+	}
+
+	private int grau(int v) {
+		return grafo.isTerminal(v) ? 0 : grafo.grau(v);
+	}
+
+	//// busca em largura a partir das origens; com parar_em_pendente devolve o primeiro no com aresta pendente
+	private int buscar(int[] origens, boolean parar_em_pendente) {
+
+		geracao = geracao + 1;
+		int cabeca = 0;
+		int cauda = 0;
+		for(int origem : origens) {
+			if(visitado[origem]==geracao) continue;
+			visitado[origem] = geracao;
+			pai[origem] = -1;
+			fila[cauda] = origem;
+			cauda = cauda + 1;
+		}
+
+		while(cabeca<cauda) {
+			int v = fila[cabeca];
+			cabeca = cabeca + 1;
+			if(parar_em_pendente && proximaPendente(v)>=0) return v;
+			if(grafo.isTerminal(v)) continue;
+
+			int linha = grafo.getLinha(v);
+			if(linha_visitada[linha]==geracao) continue;
+			linha_visitada[linha] = geracao;
+			for(int k=grafo.inicioLinha(linha);k<grafo.fimLinha(linha);k++) {
+				int u = grafo.destino(k);
+				if(visitado[u]==geracao) continue;
+				visitado[u] = geracao;
+				pai[u] = v;
+				fila[cauda] = u;
+				cauda = cauda + 1;
+			}
+		}
+		return -1;
+	}
+
+	private ArrayList<Integer> caminho(int alvo) {
+		ArrayList<Integer> caminho = new ArrayList<Integer>();
+		for(int v=alvo;v>=0;v=pai[v]) {
+			caminho.add(0, v);
+		}
+		return caminho;
+	}
+
+	private int profundidade(int alvo) {
+		int profundidade = 0;
+		for(int v=pai[alvo];v>=0;v=pai[v]) {
+			profundidade = profundidade + 1;
+		}
+		return profundidade;
+	}
+
+	private int[] entradas() {
+		int quantidade = 0;
+		for(int v=0;v<grafo.quantidadeNos();v++) {
+			if(grafo.isEntrada(v)) quantidade = quantidade + 1;
+		}
+		int[] entradas = new int[quantidade];
+		int i = 0;
+		for(int v=0;v<grafo.quantidadeNos();v++) {
+			if(grafo.isEntrada(v)) {
+				entradas[i] = v;
+				i = i + 1;
+			}
+		}
+		return entradas;
+	}
+
+	public ArrayList<int[]> getSequencias() {
+		return sequencias;
+	}
+
+	//// arestas que nenhuma sequencia pode cobrir (origem inalcancavel a partir das entradas, ou terminal)
+	public long getInalcancaveis() {
+		return inalcancaveis;
+	}
+
+	//// arestas alcancaveis que ficaram sem cobertura por causa do tamanho maximo das sequencias
+	public long getPendentes() {
+		return pendentes;
+	}
+
+	public long gravar(String caminho_arquivo) throws IOException {
+		Writer saida = ArquivoSaida.abrirTexto(caminho_arquivo);
+		try {
+			StringBuilder linha = new StringBuilder();
+			for(int[] sequencia : sequencias) {
+				linha.setLength(0);
+				GeradorSequencias.formatar(grafo, sequencia, linha);
+				saida.write(linha.toString());
+			}
+		} finally {
+			saida.close();
+		}
+		return sequencias.size();
+	}
+
+}
@@ -3,21 +3,49 @@ package leitura_interface;
 import java.io.BufferedReader;
 import java.io.FileReader;
 import java.io.IOException;
+import java.util.ArrayList;
+import java.util.Collections;
 import java.util.LinkedList;
+import java.util.List;
 
+//// visao (flyweight) de um componente: os campos ficam nos vetores de um ArmazemComponentes
+//// e o objeto guarda so o armazem e o indice. Ate ser adotado pela janela, os campos ficam num
+//// Avulso pequeno, descartado na adocao.
 public class Componente {
 	
-	private nome_componente tipo;
-	private tipo_no tipo_no;
-	private String funcao_acao;
-	private String nome_variavel; 
-	private LinkedList<Componente> nos_que_saem; 
+	private ArmazemComponentes armazem;
+	private int indice;
+	private Avulso avulso;
 	
 	public Componente(){
-		nos_que_saem = new LinkedList<Componente>();
+		avulso = new Avulso();
 	}
 
-	
+	// estado de um componente que ainda nao esta em nenhum armazem
+	private static class Avulso {
+		nome_componente tipo;
+		tipo_no tipo_no;
+		int id_nome = TabelaSimbolos.NENHUM;
+		int id_funcao = TabelaSimbolos.NENHUM;
+		int linha_fonte;
+		Container container;
+		LinkedList<String> dialogos;
+		ArrayList<Componente> saidas;
+	}
+
+	ArmazemComponentes getArmazem() {
+		return armazem;
+	}
+
+	int getIndice() {
+		return indice;
+	}
+
+	void mover(ArmazemComponentes armazem, int indice) {
+		this.armazem = armazem;
+		this.indice = indice;
+		this.avulso = null;
+	}
 
 	public void identificar_acao(String caminho_arquivo_interface_cpp) {
 			
@@ -37,7 +65,7 @@ public class Componente {
 		    		  linha = lerArq.readLine();
 		    		  continue;
 		    	  }
-		    	  if(linha.contains("connect") && linha.contains(this.nome_variavel)) {
+		    	  if(linha.contains("connect") && linha.contains(getNome_variavel())) {
 		    		  
 		    		  
 		    		  
@@ -59,51 +87,121 @@ public class Componente {
 		    	  
 		      }	
 		      arq.close();
-		      funcao_acao = pega_nome;
+		      setFuncao_acao(pega_nome);
 		    } catch (IOException e) {
 		        System.err.printf("Erro na abertura do arquivo: %s.\n Classe: Window_qt metodo: identificar_no_terminal()",
 		          e.getMessage());
 		    }
 	}   
 	
+	//// mesma busca de identificar_acao(String), sobre as linhas de connect ja lidas pela janela
+	public void identificar_acao(List<String> indice_connect) {
+
+		String pega_nome = "";
+		for(String linha : indice_connect) {
+			if(linha.contains(getNome_variavel())) {
+				String[] palavras = linha.split(",");
+				pega_nome = palavras[3];
+				pega_nome = pega_nome.replace("slot", "");
+				pega_nome = pega_nome.replace("(", "");
+				pega_nome = pega_nome.replace(")", "");
+				pega_nome = pega_nome.replace(";", "");
+				pega_nome = pega_nome.replace(" ", "");
+				break;
+			}
+		}
+		setFuncao_acao(pega_nome);
+	}
+	
 	public void addNo(Componente no) {
-		nos_que_saem.add(no);
+		if(avulso!=null) {
+			if(avulso.saidas==null) avulso.saidas = new ArrayList<Componente>(2);
+			avulso.saidas.add(no);
+		}
+		else armazem.ligar(indice, no);
 	}
 	
-	public LinkedList<Componente> getNos_que_saem() {
-		return nos_que_saem;
+	//// visao somente leitura das saidas, na ordem de addNo
+	public List<Componente> getNos_que_saem() {
+		if(avulso!=null) return avulso.saidas==null ? Collections.<Componente>emptyList() : Collections.unmodifiableList(avulso.saidas);
+		return armazem.getSaidas(indice);
 	}
 	
 	public tipo_no getTipo_no() {
-		return tipo_no;
+		return avulso!=null ? avulso.tipo_no : armazem.getTipo_no(indice);
 	}
 
 	public void setTipo_no(tipo_no tipo_no) {
-		this.tipo_no = tipo_no;
+		if(avulso!=null) avulso.tipo_no = tipo_no;
+		else armazem.setTipo_no(indice, tipo_no);
 	}
 	
 	public nome_componente getTipo() {
-		return tipo;
+		return avulso!=null ? avulso.tipo : armazem.getTipo(indice);
 	}
 
 	public void setTipo(nome_componente tipo) {
-		this.tipo = tipo;
+		if(avulso!=null) avulso.tipo = tipo;
+		else armazem.setTipo(indice, tipo);
 	}
 	
 	public String getNome_variavel() {
-		return nome_variavel;
+		return TabelaSimbolos.getInstance().nome(getId_nome());
 	}
 
 	public void setNome_variavel(String nome) {
-		nome_variavel = nome;
+		int id = TabelaSimbolos.getInstance().id(nome);
+		if(avulso!=null) avulso.id_nome = id;
+		else armazem.setId_nome(indice, id);
+	}
+
+	//// id do nome na TabelaSimbolos: dois componentes tem o mesmo nome se e so se tem o mesmo id
+	public int getId_nome() {
+		return avulso!=null ? avulso.id_nome : armazem.getId_nome(indice);
 	}
 
 	public String getFuncao_acao() {
-		return funcao_acao;
+		return TabelaSimbolos.getInstance().nome(getId_funcao());
 	}
 
 	public void setFuncao_acao(String funcao_acao) {
-		this.funcao_acao = funcao_acao;
+		int id = TabelaSimbolos.getInstance().id(funcao_acao);
+		if(avulso!=null) avulso.id_funcao = id;
+		else armazem.setId_funcao(indice, id);
+	}
+
+	public int getId_funcao() {
+		return avulso!=null ? avulso.id_funcao : armazem.getId_funcao(indice);
+	}
+
+	public void addDialogo_invocado(String dialogo) {
+		if(avulso!=null) getDialogos_invocados().add(dialogo);
+		else armazem.addDialogo(indice, dialogo);
+	}
+
+	public LinkedList<String> getDialogos_invocados() {
+		if(avulso==null) return armazem.getDialogos(indice);
+		if(avulso.dialogos==null) avulso.dialogos = new LinkedList<String>();
+		return avulso.dialogos;
+	}
+
+	//// linha do .ui onde o widget foi declarado (0 para os nos criados pelo tradutor)
+	public int getLinha_fonte() {
+		return avulso!=null ? avulso.linha_fonte : armazem.getLinha_fonte(indice);
+	}
+
+	public void setLinha_fonte(int linha_fonte) {
+		if(avulso!=null) avulso.linha_fonte = linha_fonte;
+		else armazem.setLinha_fonte(indice, linha_fonte);
+	}
+
+	public Container getContainer() {
+		return avulso!=null ? avulso.container : armazem.getContainer(indice);
+	}
+
+	public void setContainer(Container container) {
+		if(avulso!=null) avulso.container = container;
+		else armazem.setContainer(indice, container);
 	}
 	
 	
@@ -0,0 +1,101 @@
+package leitura_interface;
+
+//// conta as sequencias que GeradorSequencias produziria, sem enumera-las
+////
+//// programacao dinamica sobre o tamanho: quantidade[v] e o numero de prefixos de tamanho l que
+//// terminam em v. Os prefixos que chegam em um terminal sao contados e nao seguem adiante; os outros
+//// sao somados por linha de adjacencia, entao uma clique de nos medio custa uma soma por linha em vez
+//// de uma por aresta: O(k * (nos + destinos das linhas distintas)) operacoes.
+
+import java.math.BigInteger;
+import java.util.Arrays;
+
+public class ContadorCaminhos {
+
+	private GrafoEFG grafo;
+	private int tamanho_maximo;
+	private BigInteger[] por_terminal;
+	private BigInteger[] por_tamanho;
+	private BigInteger total;
+
+	public ContadorCaminhos(GrafoEFG grafo, int tamanho_maximo) {
+		this.grafo = grafo;
+		this.tamanho_maximo = tamanho_maximo;
+		contar();
+	}
+
+	private void contar() {
+
+		int n = grafo.quantidadeNos();
+		por_terminal = new BigInteger[n];
+		Arrays.fill(por_terminal, BigInteger.ZERO);
+		por_tamanho = new BigInteger[Math.max(tamanho_maximo, 0)+1];
+		Arrays.fill(por_tamanho, BigInteger.ZERO);
+		total = BigInteger.ZERO;
+
+		BigInteger[] quantidade = new BigInteger[n];
+		BigInteger[] proxima = new BigInteger[n];
+		BigInteger[] soma_linha = new BigInteger[grafo.quantidadeLinhas()];
+		for(int v=0;v<n;v++) {
+			quantidade[v] = grafo.isEntrada(v) ? BigInteger.ONE : BigInteger.ZERO;
+		}
+
+		for(int l=1;l<=tamanho_maximo;l++) {
+
+			Arrays.fill(soma_linha, BigInteger.ZERO);
+			for(int v=0;v<n;v++) {
+				if(quantidade[v].signum()==0) continue;
+				if(grafo.isTerminal(v)) {
+					por_terminal[v] = por_terminal[v].add(quantidade[v]);
+					por_tamanho[l] = por_tamanho[l].add(quantidade[v]);
+				}
+				else {
+					soma_linha[grafo.getLinha(v)] = soma_linha[grafo.getLinha(v)].add(quantidade[v]);
+				}
+			}
+			total = total.add(por_tamanho[l]);
+			if(l==tamanho_maximo) break;
+
+			Arrays.fill(proxima, BigInteger.ZERO);
+			for(int r=0;r<soma_linha.length;r++) {
+				if(soma_linha[r].signum()==0) continue;
+				for(int k=grafo.inicioLinha(r);k<grafo.fimLinha(r);k++) {
+					int destino = grafo.destino(k);
+					proxima[destino] = proxima[destino].add(soma_linha[r]);
+				}
+			}
+			BigInteger[] troca = quantidade;
+			quantidade = proxima;
+			proxima = troca;
+		}
+	}
+
+	public BigInteger getTotal() {
+		return total;
+	}
+
+	//// sequencias que terminam no terminal t
+	public BigInteger getPorTerminal(int t) {
+		return por_terminal[t];
+	}
+
+	//// sequencias com exatamente l eventos
+	public BigInteger getPorTamanho(int l) {
+		return por_tamanho[l];
+	}
+
+	public String getRelatorio() {
+		StringBuilder relatorio = new StringBuilder();
+		relatorio.append("sequencias com ate "+tamanho_maximo+" eventos: "+total+"\n");
+		for(int l=1;l<=tamanho_maximo;l++) {
+			relatorio.append("\ttamanho "+l+": "+por_tamanho[l]+"\n");
+		}
+		for(int t=0;t<grafo.quantidadeNos();t++) {
+			if(grafo.isTerminal(t)) {
+				relatorio.append("\t"+grafo.getNome(t)+": "+por_terminal[t]+"\n");
+			}
+		}
+		return relatorio.toString();
+	}
+
+}
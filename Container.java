@@ -0,0 +1,152 @@
+package leitura_interface;
+
+//// container de widgets do .ui (janela, aba, group box, pagina de stacked widget)
+
+import java.util.LinkedList;
+
+public class Container {
+
+	private String nome;
+	private String classe;
+	private Container pai;
+	private LinkedList<Container> filhos;
+	private LinkedList<Componente> componentes;
+
+	public Container(String nome, String classe, Container pai) {
+		this.nome = nome;
+		this.classe = classe;
+		this.pai = pai;
+		filhos = new LinkedList<Container>();
+		componentes = new LinkedList<Componente>();
+		if(pai!=null) pai.add_filho(this);
+	}
+
+	// containers cujos filhos sao paginas (so uma pagina aparece na tela por vez)
+	public boolean isPaginado() {
+		return classe.equals("qtabwidget") || classe.equals("qstackedwidget") || classe.equals("qtoolbox") || classe.equals("qwizard");
+	}
+
+	// visivel quando a janela abre: nas abas/paginas so a primeira esta na tela
+	public boolean isVisivelInicialmente() {
+		if(pai==null) return true;
+		if(!pai.isVisivelInicialmente()) return false;
+		return !pai.isPaginado() || pai.getFilhos().getFirst()==this;
+	}
+
+	// primeiro evento do container: primeiro componente que nao e r_value, procurando nos filhos se necessario
+	public Componente getEntrada() {
+		for(Componente componente : componentes) {
+			if(componente.getTipo_no()!=tipo_no.r_value) return componente;
+		}
+		for(Container filho : filhos) {
+			Componente entrada = filho.getEntrada();
+			if(entrada!=null) return entrada;
+		}
+		return null;
+	}
+
+	// raiz do grupo de containers que estao na tela junto com este: sobe enquanto o pai nao e paginado.
+	// So as paginas (filhos de um container paginado) e a janela comecam grupos.
+	public Container getGrupo() {
+		Container atual = this;
+		while(atual.pai!=null && !atual.pai.isPaginado()) atual = atual.pai;
+		return atual;
+	}
+
+	// containers do grupo que comeca neste, em pre-ordem: ele e os descendentes, sem entrar nas paginas
+	// dos containers paginados (o container paginado em si faz parte do grupo)
+	public LinkedList<Container> getMembrosGrupo() {
+		LinkedList<Container> membros = new LinkedList<Container>();
+		adicionarMembros(membros);
+		return membros;
+	}
+
+	private void adicionarMembros(LinkedList<Container> membros) {
+		membros.add(this);
+		if(isPaginado()) return;
+		for(Container filho : filhos) filho.adicionarMembros(membros);
+	}
+
+	// primeiro evento do grupo que comeca neste, sem entrar nas paginas; null se o grupo nao tem eventos
+	public Componente getEntradaGrupo() {
+		for(Container membro : getMembrosGrupo()) {
+			for(Componente componente : membro.componentes) {
+				if(componente.getTipo_no()!=tipo_no.r_value) return componente;
+			}
+		}
+		return null;
+	}
+
+	// entradas dos grupos alcancaveis a partir do grupo que comeca neste: as paginas dos seus containers
+	// paginados e, se ele e uma pagina, as outras paginas do mesmo container e o grupo de fora (que continua
+	// na tela; se ele nao tem eventos, o grupo acima dele)
+	public LinkedList<Componente> getTransicoesGrupo() {
+		LinkedList<Container> membros = getMembrosGrupo();
+		LinkedList<Componente> transicoes = new LinkedList<Componente>();
+		if(pai!=null) {
+			for(Container irmao : pai.filhos) {
+				if(irmao!=this) adicionarTransicao(transicoes, membros, irmao.getEntradaPagina());
+			}
+			Container acima = pai.getGrupo();
+			while(acima!=null) {
+				Componente entrada = acima.getEntradaGrupo();
+				if(entrada!=null) {
+					adicionarTransicao(transicoes, membros, entrada);
+					break;
+				}
+				acima = acima.pai==null ? null : acima.pai.getGrupo();
+			}
+		}
+		for(Container membro : membros) {
+			if(!membro.isPaginado()) continue;
+			for(Container pagina : membro.filhos) {
+				adicionarTransicao(transicoes, membros, pagina.getEntradaPagina());
+			}
+		}
+		return transicoes;
+	}
+
+	// entrada de uma pagina: a do seu grupo ou, se so tem containers paginados, a primeira encontrada dentro dela
+	private Componente getEntradaPagina() {
+		Componente entrada = getEntradaGrupo();
+		return entrada!=null ? entrada : getEntrada();
+	}
+
+	private static void adicionarTransicao(LinkedList<Componente> transicoes, LinkedList<Container> membros, Componente entrada) {
+		if(entrada==null || membros.contains(entrada.getContainer()) || transicoes.contains(entrada)) return;
+		transicoes.add(entrada);
+	}
+
+	public void add_filho(Container filho) {
+		filhos.add(filho);
+	}
+
+	public void add_componente(Componente componente) {
+		componentes.add(componente);
+	}
+
+	public LinkedList<Componente> getComponentes() {
+		return componentes;
+	}
+
+	public LinkedList<Container> getFilhos() {
+		return filhos;
+	}
+
+	public Container getPai() {
+		return pai;
+	}
+
+	public String getNome() {
+		return nome;
+	}
+
+	public void setNome(String nome) {
+		this.nome = nome;
+	}
+
+	public String getClasse() {
+		return classe;
+	}
+
+}
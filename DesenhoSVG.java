@@ -0,0 +1,312 @@
+package leitura_interface;
+
+//// desenho em camadas (Sugiyama) feito no proprio processo, para EFGs pequenos que nao justificam chamar o dot
+////   1. ciclos: as arestas de retorno de uma busca em profundidade (a partir das entradas) sao invertidas
+////   2. camadas: caminho mais longo no grafo aciclico resultante
+////   3. arestas que pulam camadas ganham nos ficticios, um por camada intermediaria
+////   4. cruzamentos: varreduras alternadas (para baixo e para cima) ordenando cada camada pelo baricentro dos vizinhos
+////   5. coordenadas: posicao na camada e numero da camada, com as camadas centralizadas
+//// os lacos de um no nele mesmo nao sao desenhados; as arestas invertidas sao desenhadas no sentido original
+
+import java.io.IOException;
+import java.io.Writer;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.HashSet;
+import java.util.Locale;
+
+public class DesenhoSVG {
+
+	private static final double MARGEM = 20;
+	private static final double ALTURA_NO = 36;
+
+	private GrafoEFG grafo;
+	private int iteracoes = 8;
+	private double espacamento_y = 90;
+	private double espacamento_x;
+	private double[] raio_x;
+
+	// nos 0..n-1 sao os do EFG, os seguintes sao ficticios
+	private ArrayList<Integer> camada_no;
+	private ArrayList<ArrayList<Integer>> acima;
+	private ArrayList<ArrayList<Integer>> abaixo;
+	private ArrayList<ArrayList<Integer>> camadas;
+	private ArrayList<int[]> cadeias;
+	private ArrayList<Boolean> invertidas;
+	private double[] x;
+	private double[] y;
+
+	public DesenhoSVG(GrafoEFG grafo) {
+		this.grafo = grafo;
+	}
+
+	public void setIteracoes(int iteracoes) {
+		this.iteracoes = iteracoes;
+	}
+
+	public void desenhar() {
+
+		int n = grafo.quantidadeNos();
+		raio_x = new double[n];
+		double maior_raio = 30;
+		for(int v=0;v<n;v++) {
+			raio_x[v] = Math.max(30, 3.5*grafo.getNome(v).length()+10);
+			maior_raio = Math.max(maior_raio, raio_x[v]);
+		}
+		espacamento_x = 2*maior_raio + 20;
+
+		ArrayList<int[]> arestas = removerCiclos();
+		int[] camada = atribuirCamadas(arestas);
+		criarCadeias(arestas, camada);
+		ordenarCamadas();
+		posicionar();
+	}
+
+	//// arestas do grafo aciclico {a, b, invertida}; uma busca em profundidade iterativa inverte as arestas de retorno
+	private ArrayList<int[]> removerCiclos() {
+
+		int n = grafo.quantidadeNos();
+		int[] estado = new int[n];
+		int[] pilha = new int[n];
+		int[] proximo_vizinho = new int[n];
+		HashSet<Long> vistas = new HashSet<Long>();
+		ArrayList<int[]> arestas = new ArrayList<int[]>();
+
+		// entradas primeiro, para que fiquem nas primeiras camadas
+		int[] raizes = new int[n];
+		int r = 0;
+		for(int v=0;v<n;v++) if(grafo.isEntrada(v)) raizes[r++] = v;
+		for(int v=0;v<n;v++) if(!grafo.isEntrada(v)) raizes[r++] = v;
+
+		for(int raiz : raizes) {
+			if(estado[raiz]!=0) continue;
+			int topo = 0;
+			pilha[topo++] = raiz;
+			estado[raiz] = 1;
+			proximo_vizinho[raiz] = 0;
+			while(topo>0) {
+				int v = pilha[topo-1];
+				if(proximo_vizinho[v]==grafo.grau(v)) {
+					estado[v] = 2;
+					topo = topo - 1;
+					continue;
+				}
+				int u = grafo.vizinho(v, proximo_vizinho[v]);
+				proximo_vizinho[v] = proximo_vizinho[v] + 1;
+				if(u==v || !vistas.add(((long) v<<32) | u)) continue;
+
+				if(estado[u]==1) {
+					arestas.add(new int[] {u, v, 1});
+				}
+				else {
+					arestas.add(new int[] {v, u, 0});
+					if(estado[u]==0) {
+						estado[u] = 1;
+						proximo_vizinho[u] = 0;
+						pilha[topo++] = u;
+					}
+				}
+			}
+		}
+		return arestas;
+	}
+
+	//// camada de cada no pelo caminho mais longo a partir das fontes (ordem topologica de Kahn)
+	private int[] atribuirCamadas(ArrayList<int[]> arestas) {
+
+		int n = grafo.quantidadeNos();
+		int[] grau_entrada = new int[n];
+		int[] inicio = new int[n+1];
+		for(int[] aresta : arestas) {
+			grau_entrada[aresta[1]]++;
+			inicio[aresta[0]+1]++;
+		}
+		for(int v=0;v<n;v++) inicio[v+1] += inicio[v];
+		int[] saidas = new int[arestas.size()];
+		int[] posicao = Arrays.copyOf(inicio, n);
+		for(int[] aresta : arestas) {
+			saidas[posicao[aresta[0]]] = aresta[1];
+			posicao[aresta[0]]++;
+		}
+
+		int[] camada = new int[n];
+		int[] fila = new int[n];
+		int cabeca = 0;
+		int cauda = 0;
+		for(int v=0;v<n;v++) {
+			if(grau_entrada[v]==0) fila[cauda++] = v;
+		}
+		while(cabeca<cauda) {
+			int v = fila[cabeca++];
+			for(int k=inicio[v];k<inicio[v+1];k++) {
+				int u = saidas[k];
+				camada[u] = Math.max(camada[u], camada[v]+1);
+				grau_entrada[u]--;
+				if(grau_entrada[u]==0) fila[cauda++] = u;
+			}
+		}
+		return camada;
+	}
+
+	private void criarCadeias(ArrayList<int[]> arestas, int[] camada) {
+
+		int n = grafo.quantidadeNos();
+		camada_no = new ArrayList<Integer>();
+		acima = new ArrayList<ArrayList<Integer>>();
+		abaixo = new ArrayList<ArrayList<Integer>>();
+		for(int v=0;v<n;v++) novoNo(camada[v]);
+
+		cadeias = new ArrayList<int[]>();
+		invertidas = new ArrayList<Boolean>();
+		for(int[] aresta : arestas) {
+			int a = aresta[0];
+			int b = aresta[1];
+			int[] cadeia = new int[camada[b]-camada[a]+1];
+			cadeia[0] = a;
+			for(int l=camada[a]+1;l<camada[b];l++) {
+				cadeia[l-camada[a]] = novoNo(l);
+			}
+			cadeia[cadeia.length-1] = b;
+			for(int i=0;i+1<cadeia.length;i++) {
+				abaixo.get(cadeia[i]).add(cadeia[i+1]);
+				acima.get(cadeia[i+1]).add(cadeia[i]);
+			}
+			cadeias.add(cadeia);
+			invertidas.add(aresta[2]==1);
+		}
+
+		camadas = new ArrayList<ArrayList<Integer>>();
+		for(int v=0;v<camada_no.size();v++) {
+			while(camadas.size()<=camada_no.get(v)) camadas.add(new ArrayList<Integer>());
+			camadas.get(camada_no.get(v)).add(v);
+		}
+	}
+
+	private int novoNo(int camada) {
+		camada_no.add(camada);
+		acima.add(new ArrayList<Integer>());
+		abaixo.add(new ArrayList<Integer>());
+		return camada_no.size()-1;
+	}
+
+	private void ordenarCamadas() {
+
+		final double[] posicao = new double[camada_no.size()];
+		for(ArrayList<Integer> nos : camadas) {
+			for(int i=0;i<nos.size();i++) posicao[nos.get(i)] = i;
+		}
+
+		for(int iteracao=0;iteracao<iteracoes;iteracao++) {
+			boolean descendo = iteracao%2==0;
+			for(int passo=1;passo<camadas.size();passo++) {
+				int l = descendo ? passo : camadas.size()-1-passo;
+				ArrayList<Integer> nos = camadas.get(l);
+				final double[] baricentro = new double[camada_no.size()];
+				for(int v : nos) {
+					ArrayList<Integer> vizinhos = descendo ? acima.get(v) : abaixo.get(v);
+					if(vizinhos.isEmpty()) {
+						baricentro[v] = posicao[v];
+						continue;
+					}
+					double soma = 0;
+					for(int u : vizinhos) soma = soma + posicao[u];
+					baricentro[v] = soma/vizinhos.size();
+				}
+				// ordenacao estavel: empates mantem a ordem atual
+				Collections.sort(nos, (a, b) -> Double.compare(baricentro[a], baricentro[b]));
+				for(int i=0;i<nos.size();i++) posicao[nos.get(i)] = i;
+			}
+		}
+	}
+
+	private void posicionar() {
+
+		x = new double[camada_no.size()];
+		y = new double[camada_no.size()];
+		int mais_larga = 0;
+		for(ArrayList<Integer> nos : camadas) mais_larga = Math.max(mais_larga, nos.size());
+		for(int l=0;l<camadas.size();l++) {
+			ArrayList<Integer> nos = camadas.get(l);
+			double deslocamento = (mais_larga - nos.size())/2.0;
+			for(int i=0;i<nos.size();i++) {
+				x[nos.get(i)] = MARGEM + espacamento_x/2 + (i+deslocamento)*espacamento_x;
+				y[nos.get(i)] = MARGEM + ALTURA_NO/2 + l*espacamento_y;
+			}
+		}
+	}
+
+	public String exportarSVG() {
+
+		if(x==null) desenhar();
+		int mais_larga = 0;
+		for(ArrayList<Integer> nos : camadas) mais_larga = Math.max(mais_larga, nos.size());
+		double largura = 2*MARGEM + mais_larga*espacamento_x;
+		double altura = 2*MARGEM + ALTURA_NO + Math.max(camadas.size()-1, 0)*espacamento_y;
+
+		StringBuilder svg = new StringBuilder();
+		svg.append(String.format(Locale.ROOT, "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%.0f\" height=\"%.0f\" viewBox=\"0 0 %.0f %.0f\">\n", largura, altura, largura, altura));
+		svg.append("<defs><marker id=\"seta\" viewBox=\"0 0 10 10\" refX=\"10\" refY=\"5\" markerWidth=\"8\" markerHeight=\"8\" orient=\"auto\"><path d=\"M0,0 L10,5 L0,10 z\"/></marker></defs>\n");
+
+		for(int e=0;e<cadeias.size();e++) {
+			int[] cadeia = cadeias.get(e);
+			double[] px = new double[cadeia.length];
+			double[] py = new double[cadeia.length];
+			for(int i=0;i<cadeia.length;i++) {
+				int j = invertidas.get(e) ? cadeia.length-1-i : i;
+				px[i] = x[cadeia[j]];
+				py[i] = y[cadeia[j]];
+			}
+			int origem = cadeia[invertidas.get(e) ? cadeia.length-1 : 0];
+			int destino = cadeia[invertidas.get(e) ? 0 : cadeia.length-1];
+			// as pontas param na borda das elipses
+			recortar(px, py, 0, 1, raio_x[origem]);
+			recortar(px, py, px.length-1, px.length-2, raio_x[destino]);
+
+			svg.append("<polyline fill=\"none\" stroke=\"black\" marker-end=\"url(#seta)\" points=\"");
+			for(int i=0;i<px.length;i++) {
+				svg.append(String.format(Locale.ROOT, "%s%.1f,%.1f", i>0 ? " " : "", px[i], py[i]));
+			}
+			svg.append("\"/>\n");
+		}
+
+		for(int v=0;v<grafo.quantidadeNos();v++) {
+			String estilo = "";
+			if(grafo.isTerminal(v)) estilo = " stroke-width=\"2\"";
+			else if(grafo.getTipo_no(v)==tipo_no.r_value) estilo = " stroke-dasharray=\"4,2\"";
+			svg.append(String.format(Locale.ROOT, "<ellipse cx=\"%.1f\" cy=\"%.1f\" rx=\"%.1f\" ry=\"%.1f\" fill=\"white\" stroke=\"black\"%s/>\n", x[v], y[v], raio_x[v], ALTURA_NO/2, estilo));
+			svg.append(String.format(Locale.ROOT, "<text x=\"%.1f\" y=\"%.1f\" text-anchor=\"middle\" dominant-baseline=\"central\" font-family=\"Times,serif\" font-size=\"12\">%s</text>\n", x[v], y[v], escapar(grafo.getNome(v))));
+		}
+
+		svg.append("</svg>\n");
+		return svg.toString();
+	}
+
+	// move o ponto "ponta" para a borda da elipse centrada nele, na direcao do ponto "vizinho"
+	private static void recortar(double[] px, double[] py, int ponta, int vizinho, double raio) {
+		double dx = px[vizinho] - px[ponta];
+		double dy = py[vizinho] - py[ponta];
+		double escala = Math.sqrt((dx/raio)*(dx/raio) + (dy/(ALTURA_NO/2))*(dy/(ALTURA_NO/2)));
+		if(escala<=1) return;
+		px[ponta] = px[ponta] + dx/escala;
+		py[ponta] = py[ponta] + dy/escala;
+	}
+
+	private static String escapar(String texto) {
+		return texto.replace("&", "&amp;").replace("<", "&lt;").replace(">", "&gt;").replace("\"", "&quot;");
+	}
+
+	public void gravar(String caminho_arquivo) {
+		try {
+			Writer saida = ArquivoSaida.abrirTexto(caminho_arquivo);
+			try {
+				saida.write(exportarSVG());
+			} finally {
+				saida.close();
+			}
+		} catch (IOException e) {
+			System.err.printf("Erro na abertura do arquivo: %s.\n Classe: DesenhoSVG metodo: gravar()", e.getMessage());
+		}
+	}
+
+}
@@ -1,7 +1,13 @@
 package leitura_interface;
-import java.io.FileWriter;
 import java.io.IOException;
-import java.io.PrintWriter;
+import java.io.StringWriter;
+import java.io.Writer;
+import java.util.ArrayList;
+import java.util.LinkedHashMap;
+import java.util.LinkedList;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
 
 public class EFG {
 	
@@ -22,42 +28,63 @@ public class EFG {
 	
 	public void construirEFG() {
 		
-		int componentes = 0;
-		for(Window janela : minha_interface.getJanelas()) {
-			for(Componente componente : janela.getComponentes()) {
-				componentes = componentes + 1;
+		// as janelas nao compartilham componentes: cada fragmento do EFG e construido em paralelo
+		ExecutorService executor = Executors.newFixedThreadPool(Runtime.getRuntime().availableProcessors());
+		boolean concluido = false;
+		try {
+			LinkedList<Future<?>> tarefas = new LinkedList<Future<?>>();
+			for(Window janela : minha_interface.getJanelas()) {
+				tarefas.add(executor.submit(() -> construirEFGJanela(janela)));
 			}
+			Interface.aguardar(tarefas);
+			concluido = !Thread.currentThread().isInterrupted();
+		} finally {
+			if(concluido) executor.shutdown();
+			else executor.shutdownNow();
 		}
+	}
+
+	public void construirEFGJanela(Window janela) {
 		
-		for(Window janela : minha_interface.getJanelas()) {
-			
-			if(janela.getComponentes().size()==0) continue;
-			int no_comparado = 0;
-			int itens_interface = janela.getComponentes().size();
-			int i = 1;
-			
-			
-			for(Componente componente : janela.getComponentes()) {
-				
-				i = 0;
-				
-				while(i<itens_interface){
-					if(componente.getTipo_no()==tipo_no.medio) 
-						
-						
-						if((janela.getComponentes().get(i).getTipo_no()==tipo_no.r_value)==false) {
-							componente.addNo(janela.getComponentes().get(i));
-						} 
-					
-					i = i + 1;
-				}	
-				no_comparado = no_comparado + 1;
-				
-			}	
+		if(janela.getComponentes().size()==0) return;
+		
+		// um subgrafo por grupo de containers que estao na tela ao mesmo tempo (group boxes irmaos ficam
+		// na mesma clique); so as paginas de abas/stacked widgets comecam grupo novo, ligado pelas entradas
+		for(Container container : janela.getContainers()) {
+			if(container.getGrupo()==container) construirSubgrafo(janela, container);
+		}
+	}
 
+	private void construirSubgrafo(Window janela, Container grupo) {
+
+		LinkedList<Componente> componentes = new LinkedList<Componente>();
+		for(Container membro : grupo.getMembrosGrupo()) {
+			componentes.addAll(membro.getComponentes());
 		}
-		
+		LinkedList<Componente> transicoes = grupo.getTransicoesGrupo();
+
+		// a clique (e as transicoes) e igual para todos os nos medio do grupo: vira uma cauda
+		// compartilhada no armazem da janela, depois das saidas proprias de cada no (ex.: r_valid_)
+		ArmazemComponentes armazem = janela.getArmazem();
+		int cauda = -1;
+		for(Componente componente : componentes) {
+			
+			if(componente.getTipo_no()!=tipo_no.medio) continue;
+			
+			if(cauda<0) {
+				cauda = armazem.novaCauda();
+				for(Componente no : componentes) {
+					if((no.getTipo_no()==tipo_no.r_value)==false) {
+						armazem.ligarCauda(cauda, no);
+					}
+				}
+				for(Componente entrada : transicoes) {
+					armazem.ligarCauda(cauda, entrada);
+				}
 			}
+			armazem.usarCauda(componente.getIndice(), cauda);
+		}
+	}
 
 	public void imprimirEFG() {
 		
@@ -83,39 +110,256 @@ public class EFG {
 
 	public String exportarEFGDot() {
 		
-		String saida = "strict digraph G {"+"\n";
-		int con = 0;
+		StringWriter saida = new StringWriter();
+		try {
+			exportarEFGDot(saida);
+		} catch (IOException e) {
+			// StringWriter nao lanca IOException
+		}
+		return saida.toString();
+	}
+	
+	//// mesmo texto de exportarEFGDot(), escrito aos poucos em "saida" sem montar a String inteira
+	public void exportarEFGDot(Writer saida) throws IOException {
+		
+		saida.write("strict digraph G {"+"\n");
+		saida.write(declaracoesDot());
+		
 		for(Window janela : minha_interface.getJanelas()) {
 			for(Componente componente : janela.getComponentes()) {
-				saida = saida +"\t"+componente.getNome_variavel()+";"+"\n";
+				for(Componente no : componente.getNos_que_saem()) {
+					saida.write("\t"+id_no(janela, componente)+" -> "+id_no(janela, no)+";"+"\n");
+				}
+			}
+		}
+		
+		saida.write("}");
+	}
+	
+	//// mesmo texto de exportarEFGDot(), formatado por "threads" threads direto no arquivo
+	public long exportarEFGDotParalelo(String caminho_arquivo, int threads) throws IOException {
+		return new ExportadorDotParalelo(getGrafo()).gravar(caminho_arquivo, threads);
+	}
+	
+	//// mesmo grafo de exportarEFGDot, mas cada bloco bipartido completo vira uma unica aresta {a b c} -> {a b c}:
+	//// a clique dos nos medio de cada container (sufixo comum das linhas) e os nos com a mesma lista de saida
+	public String exportarEFGDotCompacto() {
+		
+		GrafoEFG grafo = getGrafo();
+		StringBuilder saida = new StringBuilder("strict digraph G {"+"\n");
+		saida.append(declaracoesDot());
+		
+		// os nos medio de um container tem a mesma clique (componentes do container + transicoes) no fim
+		// da linha, mas editline/combobox poem r_invalid_/r_valid_ antes dela, entao as linhas diferem.
+		// Por container: o sufixo comum das linhas dos nos medio sai uma vez, e o resto de cada linha a parte.
+		ArrayList<ArrayList<Integer>> medios = new ArrayList<ArrayList<Integer>>();
+		for(int c=0;c<grafo.quantidadeContainers();c++) {
+			medios.add(new ArrayList<Integer>());
+		}
+		for(int v=0;v<grafo.quantidadeNos();v++) {
+			if(grafo.getTipo_no(v)==tipo_no.medio && grafo.getContainer(v)>=0 && grafo.grau(v)>0) {
+				medios.get(grafo.getContainer(v)).add(v);
+			}
+		}
+		
+		// fim[v]: onde a parte propria da linha de v termina (o grau, se v nao esta em um bloco)
+		int[] fim = new int[grafo.quantidadeNos()];
+		for(int v=0;v<grafo.quantidadeNos();v++) {
+			fim[v] = grafo.grau(v);
+		}
+		for(ArrayList<Integer> grupo : medios) {
+			if(grupo.size()<2) continue;
+			int sufixo = sufixoComum(grafo, grupo);
+			if(sufixo<2) continue;
+			int v0 = grupo.get(0);
+			int inicio = grafo.inicioLinha(grafo.getLinha(v0)) + grafo.grau(v0) - sufixo;
+			aresta(saida, grafo, grupo, inicio, inicio+sufixo);
+			for(int v : grupo) {
+				fim[v] = grafo.grau(v) - sufixo;
 			}
 		}
 		
+		// partes proprias: nos com a mesma linha (e o mesmo corte) juntos, na ordem dos nos
+		LinkedHashMap<Long, ArrayList<Integer>> origens = new LinkedHashMap<Long, ArrayList<Integer>>();
+		for(int v=0;v<grafo.quantidadeNos();v++) {
+			if(fim[v]==0) continue;
+			long chave = ((long) grafo.getLinha(v)<<32) | fim[v];
+			ArrayList<Integer> lista = origens.get(chave);
+			if(lista==null) {
+				lista = new ArrayList<Integer>();
+				origens.put(chave, lista);
+			}
+			lista.add(v);
+		}
+		for(ArrayList<Integer> lista : origens.values()) {
+			int v0 = lista.get(0);
+			int inicio = grafo.inicioLinha(grafo.getLinha(v0));
+			aresta(saida, grafo, lista, inicio, inicio+fim[v0]);
+		}
+		
+		saida.append("}");
+		return saida.toString();
+	}
+	
+	// tamanho do maior sufixo comum das linhas dos nos do grupo
+	private static int sufixoComum(GrafoEFG grafo, ArrayList<Integer> grupo) {
+		int v0 = grupo.get(0);
+		int fim0 = grafo.fimLinha(grafo.getLinha(v0));
+		int sufixo = grafo.grau(v0);
+		for(int v : grupo) {
+			int fim = grafo.fimLinha(grafo.getLinha(v));
+			int t = 0;
+			while(t<sufixo && t<grafo.grau(v) && grafo.destino(fim-1-t)==grafo.destino(fim0-1-t)) t = t + 1;
+			sufixo = t;
+		}
+		return sufixo;
+	}
+	
+	// "{origens} -> {destinos[inicio, fim)}", sem chaves quando ha um so no de cada lado
+	private static void aresta(StringBuilder saida, GrafoEFG grafo, ArrayList<Integer> origens, int inicio, int fim) {
+		saida.append("\t");
+		if(origens.size()==1) {
+			saida.append(grafo.getNome(origens.get(0)));
+		}
+		else {
+			saida.append("{");
+			for(int i=0;i<origens.size();i++) {
+				if(i>0) saida.append(" ");
+				saida.append(grafo.getNome(origens.get(i)));
+			}
+			saida.append("}");
+		}
+		saida.append(" -> ");
+		if(fim-inicio==1) {
+			saida.append(grafo.getNome(grafo.destino(inicio)));
+		}
+		else {
+			saida.append("{");
+			for(int k=inicio;k<fim;k++) {
+				if(k>inicio) saida.append(" ");
+				saida.append(grafo.getNome(grafo.destino(k)));
+			}
+			saida.append("}");
+		}
+		saida.append(";"+"\n");
+	}
+	
+	private String declaracoesDot() {
+		
+		StringBuilder saida = new StringBuilder();
+		boolean varias_janelas = minha_interface.getJanelas().size()>1;
+		GraphViz gv = new GraphViz();
+		int cluster = 0;
+		for(Window janela : minha_interface.getJanelas()) {
+			String recuo = "\t";
+			if(varias_janelas) {
+				saida.append("\t"+gv.start_subgraph(cluster)+"\n");
+				saida.append("\t\tlabel=\""+janela.getNome()+"\";"+"\n");
+				recuo = "\t\t";
+				cluster = cluster + 1;
+			}
+			for(Componente componente : janela.getComponentes()) {
+				saida.append(recuo+id_no(janela, componente)+";"+"\n");
+			}
+			if(varias_janelas) {
+				saida.append("\t"+gv.end_subgraph()+"\n");
+			}
+		}
+		return saida.toString();
+	}
+	
+	//// com varias janelas o nome do no e qualificado pela janela (os widgets podem ter o mesmo nome)
+	public String id_no(Window janela, Componente componente) {
+		if(minha_interface.getJanelas().size()>1) {
+			return janela.getNome()+"_"+componente.getNome_variavel();
+		}
+		return componente.getNome_variavel();
+	}
+
+	public String exportarEFGDotHierarquico() {
+		
+		StringBuilder saida = new StringBuilder("strict digraph G {"+"\n");
+		int[] cluster = {0};
+		for(Window janela : minha_interface.getJanelas()) {
+			escreverContainerDot(janela, janela.getRaiz(), saida, cluster, "\t");
+		}
+		
 		for(Window janela : minha_interface.getJanelas()) {
 			for(Componente componente : janela.getComponentes()) {
 				for(Componente no : componente.getNos_que_saem()) {
-					saida = saida + "\t"+componente.getNome_variavel()+" -> "+no.getNome_variavel()+";"+"\n";
+					saida.append("\t"+id_no(janela, componente)+" -> "+id_no(janela, no)+";"+"\n");
 				}
 			}
 		}
 		
-		saida = saida + "}";
-		return saida;
+		saida.append("}");
+		return saida.toString();
+	}
+	
+	private void escreverContainerDot(Window janela, Container container, StringBuilder saida, int[] cluster, String recuo) {
+		
+		saida.append(recuo+"subgraph cluster_"+cluster[0]+" {"+"\n");
+		cluster[0] = cluster[0] + 1;
+		saida.append(recuo+"\tlabel=\""+container.getNome()+"\";"+"\n");
+		for(Componente componente : container.getComponentes()) {
+			saida.append(recuo+"\t"+id_no(janela, componente)+";"+"\n");
+		}
+		for(Container filho : container.getFilhos()) {
+			escreverContainerDot(janela, filho, saida, cluster, recuo+"\t");
+		}
+		saida.append(recuo+"}"+"\n");
 	}
 	
 	
+	//// caminhos terminados em .gz sao gravados comprimidos
 	public void imprimirArquivo(String caminho_arquivo, String conteudo) throws IOException{
 
-		String caminho = caminho_arquivo;
-		
-		FileWriter saida = new FileWriter(caminho);
-		PrintWriter gravarArquivo = new PrintWriter(saida);
-
-		int id_teste = 0; 
-		gravarArquivo.print(conteudo);
+		Writer saida = ArquivoSaida.abrirTexto(caminho_arquivo);
+		saida.write(conteudo);
 		saida.close();
 	}
 	
+	//// exportarEFGDot direto para o arquivo, sem montar a String (comprimido se o caminho terminar em .gz)
+	public void exportarEFGDot(String caminho_arquivo) throws IOException {
+		Writer saida = ArquivoSaida.abrirTexto(caminho_arquivo);
+		try {
+			exportarEFGDot(saida);
+		} finally {
+			saida.close();
+		}
+	}
+	
+	//// lista de arestas "origem destino", uma por linha (comprimida se o caminho terminar em .gz)
+	public long exportarEFGArestas(String caminho_arquivo) throws IOException {
+		GrafoEFG grafo = getGrafo();
+		Writer saida = ArquivoSaida.abrirTexto(caminho_arquivo);
+		long quantidade = 0;
+		try {
+			for(int v=0;v<grafo.quantidadeNos();v++) {
+				for(int i=0;i<grafo.grau(v);i++) {
+					saida.write(grafo.getNome(v)+" "+grafo.getNome(grafo.vizinho(v, i))+"\n");
+					quantidade = quantidade + 1;
+				}
+			}
+		} finally {
+			saida.close();
+		}
+		return quantidade;
+	}
+	
+	
+	//// o mesmo grafo de getGrafo() como Graph do JGraphT, sem copia
+	public VisaoJGraphT getGrafoJGraphT() {
+		return new VisaoJGraphT(getGrafo());
+	}
+	
+	public void exportarEFGBinario(String caminho_arquivo) throws IOException {
+		EFGBinario.gravar(getGrafo(), caminho_arquivo);
+	}
+	
+	public GrafoEFG getGrafo() {
+		return new GrafoEFG(minha_interface.getJanelas());
+	}
 	
 	public Interface getInterface() {
 		return minha_interface;
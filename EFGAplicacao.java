@@ -0,0 +1,252 @@
+package leitura_interface;
+
+//// EFG da aplicacao inteira: um no de invocacao "dlg_<dialogo>" liga o componente cujo slot
+//// abre o dialogo ao EFG do proprio dialogo. O EFG de cada dialogo so e traduzido quando a
+//// travessia chega nele e fica em um cache LRU limitado. Um grafo que sai do cache e fechado (no modo
+//// mapeado isso apaga o arquivo das arestas): quem recebeu o grafo so pode usa-lo enquanto ele esta no cache.
+
+import java.io.File;
+import java.io.IOException;
+import java.io.Writer;
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.LinkedHashMap;
+import java.util.LinkedList;
+import java.util.Map;
+
+public class EFGAplicacao {
+
+	public static EFGAplicacao uniqueInstance;
+	private HashMap<String, String[]> dialogos_registrados;
+	private LinkedHashMap<String, GrafoEFG> cache;
+	private int capacidade_cache;
+	private ArmazemFragmentos armazem;
+	private int geracao_simbolos;
+
+	private EFGAplicacao() {
+		dialogos_registrados = new HashMap<String, String[]>();
+		capacidade_cache = 16;
+		cache = new LinkedHashMap<String, GrafoEFG>(16, 0.75f, true) {
+			private static final long serialVersionUID = 1L;
+
+			@Override
+			protected boolean removeEldestEntry(Map.Entry<String, GrafoEFG> mais_antigo) {
+				if(size() <= capacidade_cache) return false;
+				fechar(mais_antigo.getValue());
+				return true;
+			}
+		};
+	}
+
+	public static EFGAplicacao getInstance() {
+		if(uniqueInstance==null) {
+			uniqueInstance = new EFGAplicacao();
+		}
+		return uniqueInstance;
+	}
+
+	public String registrarDialogo(String caminho_ui, String caminho_cpp) {
+		String nome = Window.nome_dialogo(Interface.pega_nome_classe(caminho_ui));
+		dialogos_registrados.put(nome, new String[] {caminho_ui, caminho_cpp});
+		return nome;
+	}
+
+	//// registra cada subpasta organizada como read_archives (<pasta>/main.ui e <pasta>/main.cpp)
+	public void registrarPasta(String caminho_pasta) {
+		File[] pastas = new File(caminho_pasta).listFiles();
+		if(pastas==null) return;
+		Arrays.sort(pastas);
+		for(File pasta : pastas) {
+			File ui = new File(pasta, "main.ui");
+			File cpp = new File(pasta, "main.cpp");
+			if(ui.isFile() && cpp.isFile()) {
+				registrarDialogo(ui.getPath(), cpp.getPath());
+			}
+		}
+	}
+
+	public boolean isRegistrado(String nome) {
+		return dialogos_registrados.containsKey(nome);
+	}
+
+	//// EFG do dialogo; null para dialogos de biblioteca (qfiledialog, qmessagebox...) ou desconhecidos
+	public synchronized GrafoEFG getGrafoDialogo(String nome) {
+		// os grafos do cache guardam ids da TabelaSimbolos: se ela foi limpa, eles nao valem mais
+		int geracao = TabelaSimbolos.getInstance().geracao();
+		if(geracao!=geracao_simbolos) {
+			limparCache();
+			geracao_simbolos = geracao;
+		}
+		GrafoEFG grafo = cache.get(nome);
+		if(grafo!=null) return grafo;
+
+		String[] arquivos = dialogos_registrados.get(nome);
+		if(arquivos==null) return null;
+
+		grafo = carregar(arquivos[0], arquivos[1]);
+		cache.put(nome, grafo);
+		return grafo;
+	}
+
+	//// fecha e descarta todos os grafos do cache
+	public synchronized void limparCache() {
+		for(GrafoEFG grafo : cache.values()) {
+			fechar(grafo);
+		}
+		cache.clear();
+	}
+
+	private static void fechar(GrafoEFG grafo) {
+		try {
+			grafo.fechar();
+		} catch (IOException e) {
+			System.err.printf("Erro na abertura do arquivo: %s.\n Classe: EFGAplicacao metodo: fechar()\n",
+					e.getMessage());
+		}
+	}
+
+	//// com um armazem configurado, so traduz o dialogo se o .ui ou o .cpp mudou desde a ultima vez
+	private GrafoEFG carregar(String caminho_ui, String caminho_cpp) {
+
+		if(armazem==null) return traduzir(caminho_ui, caminho_cpp);
+
+		String chave;
+		try {
+			chave = armazem.chave(caminho_ui, caminho_cpp);
+		} catch (IOException e) {
+			System.err.printf("Erro na abertura do arquivo: %s.\n Classe: EFGAplicacao metodo: carregar()",
+					e.getMessage());
+			return traduzir(caminho_ui, caminho_cpp);
+		}
+
+		GrafoEFG grafo = armazem.ler(chave);
+		if(grafo==null) {
+			grafo = traduzir(caminho_ui, caminho_cpp);
+			armazem.gravar(chave, grafo);
+		}
+		return grafo;
+	}
+
+	private GrafoEFG traduzir(String caminho_ui, String caminho_cpp) {
+
+		Window janela = new Window();
+		janela.setCaminho_arquivo_interface(caminho_ui, caminho_cpp);
+		janela.setNome(Interface.pega_nome_classe(caminho_ui));
+		janela.ler_interface();
+		janela.completar();
+		janela.identificar_ligacoes();
+		EFG.getInstance().construirEFGJanela(janela);
+
+		LinkedList<Window> janelas = new LinkedList<Window>();
+		janelas.add(janela);
+		return new GrafoEFG(janelas);
+	}
+
+	//// recebe os dialogos na ordem da travessia; o grafo de cada um so e carregado quando ela chega nele
+	public interface Visitante {
+		//// false: nao expande os dialogos invocados por este
+		boolean visitar(String nome, GrafoEFG grafo, int profundidade) throws IOException;
+	}
+
+	//// travessia em largura a partir de um dialogo, expandindo os dialogos invocados ate a profundidade dada;
+	//// os EFGs passam pelo cache LRU, entao so os que estao sendo visitados precisam ficar em memoria
+	public void percorrer(String dialogo_inicial, int profundidade_maxima, Visitante visitante) throws IOException {
+
+		HashMap<String, Integer> profundidade = new HashMap<String, Integer>();
+		LinkedList<String> fila = new LinkedList<String>();
+		profundidade.put(dialogo_inicial, 0);
+		fila.add(dialogo_inicial);
+
+		while(!fila.isEmpty()) {
+
+			String nome = fila.poll();
+			GrafoEFG grafo = getGrafoDialogo(nome);
+			if(grafo==null) continue;
+
+			int atual = profundidade.get(nome);
+			if(!visitante.visitar(nome, grafo, atual) || atual>=profundidade_maxima) continue;
+
+			for(int v=0;v<grafo.quantidadeNos();v++) {
+				for(int i=0;i<grafo.quantidadeDialogos(v);i++) {
+					String dialogo = grafo.getDialogo(v, i);
+					if(!profundidade.containsKey(dialogo)) {
+						profundidade.put(dialogo, atual+1);
+						fila.add(dialogo);
+					}
+				}
+			}
+		}
+	}
+
+	//// DOT da aplicacao: um cluster por dialogo alcancado por percorrer()
+	public void exportarDot(String dialogo_inicial, int profundidade_maxima, final Writer saida) throws IOException {
+
+		final GraphViz gv = new GraphViz();
+		final HashSet<String> nos_invocacao = new HashSet<String>();
+		final HashMap<String, String> entradas = new HashMap<String, String>();
+		final int[] cluster = {0};
+
+		saida.write("strict digraph G {"+"\n");
+		percorrer(dialogo_inicial, profundidade_maxima, new Visitante() {
+			@Override
+			public boolean visitar(String nome, GrafoEFG grafo, int profundidade) throws IOException {
+
+				saida.write("\t"+gv.start_subgraph(cluster[0])+"\n");
+				saida.write("\t\tlabel=\""+nome+"\";"+"\n");
+				for(int v=0;v<grafo.quantidadeNos();v++) {
+					saida.write("\t\t"+nome+"_"+grafo.getNome(v)+";"+"\n");
+				}
+				saida.write("\t"+gv.end_subgraph()+"\n");
+				cluster[0] = cluster[0] + 1;
+
+				int entrada = grafo.getEntradaJanela(0);
+				if(entrada>=0) {
+					entradas.put(nome, nome+"_"+grafo.getNome(entrada));
+					if(nos_invocacao.contains(nome)) {
+						saida.write("\tdlg_"+nome+" -> "+entradas.get(nome)+";"+"\n");
+					}
+				}
+
+				for(int v=0;v<grafo.quantidadeNos();v++) {
+					for(int i=0;i<grafo.grau(v);i++) {
+						saida.write("\t"+nome+"_"+grafo.getNome(v)+" -> "+nome+"_"+grafo.getNome(grafo.vizinho(v, i))+";"+"\n");
+					}
+					for(int i=0;i<grafo.quantidadeDialogos(v);i++) {
+						String dialogo = grafo.getDialogo(v, i);
+						if(nos_invocacao.add(dialogo)) {
+							saida.write("\tdlg_"+dialogo+" [shape=box];"+"\n");
+							if(entradas.containsKey(dialogo)) {
+								saida.write("\tdlg_"+dialogo+" -> "+entradas.get(dialogo)+";"+"\n");
+							}
+						}
+						saida.write("\t"+nome+"_"+grafo.getNome(v)+" -> dlg_"+dialogo+";"+"\n");
+					}
+				}
+				return true;
+			}
+		});
+		saida.write("}");
+	}
+
+	//// os grafos do cache podem ter vindo do armazem anterior: sao liberados
+	public synchronized void setArmazem(ArmazemFragmentos armazem) {
+		limparCache();
+		this.armazem = armazem;
+	}
+
+	public int getCapacidade_cache() {
+		return capacidade_cache;
+	}
+
+	public synchronized void setCapacidade_cache(int capacidade_cache) {
+		this.capacidade_cache = capacidade_cache;
+		// reduzir a capacidade fecha os grafos menos usados que passaram dela
+		while(cache.size()>capacidade_cache) {
+			Map.Entry<String, GrafoEFG> mais_antigo = cache.entrySet().iterator().next();
+			fechar(mais_antigo.getValue());
+			cache.remove(mais_antigo.getKey());
+		}
+	}
+
+}
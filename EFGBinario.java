@@ -0,0 +1,102 @@
+package leitura_interface;
+
+//// formato binario versionado do EFG, lido sem desserializar por LeitorEFGBinario
+////
+//// cabecalho (8 ints): assinatura "EFGB", versao, nos, linhas, destinos, textos, bytes dos textos, reservado
+//// secoes de ints:     nome[nos], funcao[nos], linha[nos], inicio[linhas+1], destino[destinos], inicio_texto[textos+1]
+//// secoes de bytes:    tipo_no[nos], nome_componente[nos] (ordinal, -1 se ausente), textos em UTF-8
+////
+//// as arestas ficam em CSR: os nos com a mesma lista de saida apontam para a mesma linha
+
+import java.io.BufferedOutputStream;
+import java.io.DataOutputStream;
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.HashMap;
+
+public class EFGBinario {
+
+	public static final int ASSINATURA = 0x45464742; // "EFGB"
+	public static final int VERSAO = 1;
+	public static final int TAMANHO_CABECALHO = 32;
+
+	public static void gravar(GrafoEFG grafo, String caminho_arquivo) throws IOException {
+
+		int n = grafo.quantidadeNos();
+		HashMap<String, Integer> indices = new HashMap<String, Integer>();
+		ArrayList<byte[]> textos = new ArrayList<byte[]>();
+		int[] nomes = new int[n];
+		int[] funcoes = new int[n];
+		for(int v=0;v<n;v++) {
+			nomes[v] = indice(indices, textos, grafo.getNome(v));
+			funcoes[v] = indice(indices, textos, grafo.getFuncao_acao(v));
+		}
+		long bytes_textos = 0;
+		for(byte[] texto : textos) {
+			bytes_textos = bytes_textos + texto.length;
+		}
+		if(bytes_textos>Integer.MAX_VALUE) throw new IOException("textos do EFG passam de 2 GB: "+bytes_textos+" bytes");
+
+		int linhas = grafo.quantidadeLinhas();
+		int total_destinos = grafo.quantidadeDestinos();
+
+		// em caso de erro o arquivo pela metade e apagado
+		File arquivo = new File(caminho_arquivo);
+		DataOutputStream saida = new DataOutputStream(new BufferedOutputStream(new FileOutputStream(arquivo)));
+		boolean concluido = false;
+		try {
+			saida.writeInt(ASSINATURA);
+			saida.writeInt(VERSAO);
+			saida.writeInt(n);
+			saida.writeInt(linhas);
+			saida.writeInt(total_destinos);
+			saida.writeInt(textos.size());
+			saida.writeInt((int) bytes_textos);
+			saida.writeInt(0);
+
+			for(int v=0;v<n;v++) saida.writeInt(nomes[v]);
+			for(int v=0;v<n;v++) saida.writeInt(funcoes[v]);
+			for(int v=0;v<n;v++) saida.writeInt(grafo.getLinha(v));
+			for(int r=0;r<linhas;r++) saida.writeInt(grafo.inicioLinha(r));
+			saida.writeInt(total_destinos);
+			for(int k=0;k<total_destinos;k++) saida.writeInt(grafo.destino(k));
+
+			int posicao = 0;
+			for(byte[] texto : textos) {
+				saida.writeInt(posicao);
+				posicao = posicao + texto.length;
+			}
+			saida.writeInt(posicao);
+
+			for(int v=0;v<n;v++) saida.writeByte(grafo.getTipo_no(v)==null ? -1 : grafo.getTipo_no(v).ordinal());
+			for(int v=0;v<n;v++) saida.writeByte(grafo.getTipo(v)==null ? -1 : grafo.getTipo(v).ordinal());
+			for(byte[] texto : textos) saida.write(texto);
+
+			saida.close();
+			concluido = true;
+		} finally {
+			if(!concluido) {
+				try {
+					saida.close();
+				} catch (IOException ignorada) {
+				}
+				arquivo.delete();
+			}
+		}
+	}
+
+	private static int indice(HashMap<String, Integer> indices, ArrayList<byte[]> textos, String texto) {
+		if(texto==null) return -1;
+		Integer indice = indices.get(texto);
+		if(indice==null) {
+			indice = textos.size();
+			indices.put(texto, indice);
+			textos.add(texto.getBytes(StandardCharsets.UTF_8));
+		}
+		return indice;
+	}
+
+}
@@ -0,0 +1,310 @@
+package leitura_interface;
+
+//// enumeracao paralela das sequencias de GeradorSequencias, dividindo a arvore de busca por prefixo
+//// em um ForkJoinPool (roubo de tarefas). Cada prefixo produz a sua propria saida e as saidas sao
+//// escritas na ordem dos prefixos, entao a saida e identica a da enumeracao sequencial.
+//// A saida de um prefixo e uma lista de trechos de ate TAMANHO_TRECHO bytes. Os trechos de todos os
+//// prefixos ainda nao escritos somam no maximo LIMITE_MEMORIA bytes (contador global em_memoria);
+//// passando disso, o resto do prefixo vai para um arquivo temporario, copiado e apagado na hora de escrever.
+
+import java.io.BufferedOutputStream;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.io.UncheckedIOException;
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.LinkedList;
+import java.util.Map;
+import java.util.TreeMap;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ForkJoinPool;
+import java.util.concurrent.ForkJoinTask;
+import java.util.concurrent.RecursiveTask;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicLong;
+
+public class EnumeradorParalelo {
+
+	private static final int TAMANHO_TRECHO = 1<<20;
+	private static final long LIMITE_MEMORIA = 64L<<20;
+
+	private GrafoEFG grafo;
+	private int tamanho_maximo;
+	private int threads;
+	private int niveis_divisao;
+	private TabelasDistancia tabelas;
+	private ConcurrentHashMap<String, AtomicLong[]> vazao;
+	private AtomicLong em_memoria = new AtomicLong();
+	private long tempo_total;
+
+	public EnumeradorParalelo(GrafoEFG grafo, int tamanho_maximo, int threads) {
+		this.grafo = grafo;
+		this.tamanho_maximo = tamanho_maximo;
+		this.threads = threads;
+		this.niveis_divisao = 2;
+		this.tabelas = new TabelasDistancia(grafo);
+		vazao = new ConcurrentHashMap<String, AtomicLong[]>();
+	}
+
+	public long gravar(String caminho_arquivo) throws IOException {
+		OutputStream saida = ArquivoSaida.abrir(caminho_arquivo);
+		try {
+			return gravar(saida);
+		} finally {
+			saida.close();
+		}
+	}
+
+	public long gravar(OutputStream saida) throws IOException {
+
+		long comeco = System.nanoTime();
+		vazao.clear();
+		ForkJoinPool pool = new ForkJoinPool(threads);
+		ArrayList<int[]> prefixos = dividir(4*threads);
+
+		// no maximo "janela" prefixos em andamento: a memoria fica limitada aos buffers ainda nao escritos
+		int janela = 2*threads;
+		LinkedList<ForkJoinTask<Resultado>> em_andamento = new LinkedList<ForkJoinTask<Resultado>>();
+		int proximo = 0;
+		long quantidade = 0;
+		boolean concluido = false;
+		try {
+			while(proximo<prefixos.size() || !em_andamento.isEmpty()) {
+				while(proximo<prefixos.size() && em_andamento.size()<janela) {
+					em_andamento.add(pool.submit(new Prefixo(prefixos.get(proximo), prefixos.get(proximo).length+niveis_divisao)));
+					proximo = proximo + 1;
+				}
+				Resultado resultado = em_andamento.poll().join();
+				resultado.escrever(saida);
+				quantidade = quantidade + resultado.sequencias;
+			}
+			saida.flush();
+			concluido = true;
+		} finally {
+			if(concluido) pool.shutdown();
+			else {
+				// erro: as tarefas na fila sao canceladas e as que estao rodando terminam antes de
+				// apagar os temporarios dos prefixos que nao chegaram a ser escritos
+				pool.shutdownNow();
+				try {
+					pool.awaitTermination(Long.MAX_VALUE, TimeUnit.NANOSECONDS);
+				} catch (InterruptedException e) {
+					Thread.currentThread().interrupt();
+				}
+				for(ForkJoinTask<Resultado> tarefa : em_andamento) {
+					if(tarefa.isDone() && tarefa.isCompletedNormally()) tarefa.join().descartar();
+				}
+			}
+		}
+
+		tempo_total = System.nanoTime() - comeco;
+		return quantidade;
+	}
+
+	//// prefixos iniciais em ordem de busca em profundidade: cada prefixo expandido e trocado, no mesmo lugar, pelos seus filhos
+	private ArrayList<int[]> dividir(int alvo) {
+
+		ArrayList<int[]> prefixos = new ArrayList<int[]>();
+		if(tamanho_maximo<=0) return prefixos;
+		for(int v=0;v<grafo.quantidadeNos();v++) {
+			if(grafo.isEntrada(v) && tabelas.podeTerminar(v, 1, tamanho_maximo)) prefixos.add(new int[] {v});
+		}
+
+		boolean expandiu = true;
+		while(prefixos.size()<alvo && expandiu) {
+			expandiu = false;
+			ArrayList<int[]> proximos = new ArrayList<int[]>();
+			for(int[] prefixo : prefixos) {
+				int ultimo = prefixo[prefixo.length-1];
+				if(grafo.isTerminal(ultimo) || prefixo.length>=tamanho_maximo || grafo.grau(ultimo)==0) {
+					proximos.add(prefixo);
+					continue;
+				}
+				for(int i=0;i<grafo.grau(ultimo);i++) {
+					if(!tabelas.podeTerminar(grafo.vizinho(ultimo, i), prefixo.length+1, tamanho_maximo)) continue;
+					int[] filho = Arrays.copyOf(prefixo, prefixo.length+1);
+					filho[prefixo.length] = grafo.vizinho(ultimo, i);
+					proximos.add(filho);
+				}
+				expandiu = true;
+			}
+			prefixos = proximos;
+		}
+		return prefixos;
+	}
+
+	// saida de um prefixo: trechos em memoria (byte[]) e, se passou do limite, um arquivo temporario no fim
+	private class Resultado {
+		ArrayList<Object> partes = new ArrayList<Object>();
+		long sequencias;
+		long bytes;
+
+		void juntar(Resultado outro) {
+			partes.addAll(outro.partes);
+			sequencias = sequencias + outro.sequencias;
+			bytes = bytes + outro.bytes;
+			outro.partes.clear();
+			outro.bytes = 0;
+		}
+
+		void escrever(OutputStream saida) throws IOException {
+			try {
+				for(Object parte : partes) {
+					if(parte instanceof byte[]) {
+						saida.write((byte[]) parte);
+						continue;
+					}
+					InputStream entrada = new FileInputStream((File) parte);
+					try {
+						byte[] buffer = new byte[1<<16];
+						int lidos;
+						while((lidos = entrada.read(buffer))!=-1) {
+							saida.write(buffer, 0, lidos);
+						}
+					} finally {
+						entrada.close();
+					}
+				}
+			} finally {
+				descartar();
+			}
+		}
+
+		void descartar() {
+			for(Object parte : partes) {
+				if(parte instanceof File) ((File) parte).delete();
+			}
+			partes.clear();
+			em_memoria.addAndGet(-bytes);
+			bytes = 0;
+		}
+	}
+
+	private class Prefixo extends RecursiveTask<Resultado> {
+
+		private static final long serialVersionUID = 1L;
+		private int[] prefixo;
+		private int limite_divisao;
+
+		Prefixo(int[] prefixo, int limite_divisao) {
+			this.prefixo = prefixo;
+			this.limite_divisao = limite_divisao;
+		}
+
+		@Override
+		protected Resultado compute() {
+
+			int ultimo = prefixo[prefixo.length-1];
+			boolean divisivel = prefixo.length<limite_divisao && prefixo.length<tamanho_maximo && !grafo.isTerminal(ultimo) && grafo.grau(ultimo)>1;
+			if(!divisivel) return enumerar();
+
+			// os filhos ficam na fila deste worker; os ociosos roubam os que ainda nao comecaram
+			ArrayList<Prefixo> filhos = new ArrayList<Prefixo>();
+			for(int i=0;i<grafo.grau(ultimo);i++) {
+				if(!tabelas.podeTerminar(grafo.vizinho(ultimo, i), prefixo.length+1, tamanho_maximo)) continue;
+				int[] filho = Arrays.copyOf(prefixo, prefixo.length+1);
+				filho[prefixo.length] = grafo.vizinho(ultimo, i);
+				filhos.add(new Prefixo(filho, limite_divisao));
+			}
+			try {
+				invokeAll(filhos);
+			} catch (RuntimeException | Error e) {
+				// um filho falhou: os irmaos que terminaram apagam os seus temporarios
+				for(Prefixo filho : filhos) {
+					filho.quietlyJoin();
+					if(filho.isCompletedNormally()) filho.getRawResult().descartar();
+				}
+				throw e;
+			}
+
+			// os trechos dos filhos sao encadeados, sem copiar bytes
+			Resultado resultado = new Resultado();
+			for(Prefixo filho : filhos) {
+				resultado.juntar(filho.join());
+			}
+			return resultado;
+		}
+
+		private Resultado enumerar() {
+
+			long comeco = System.nanoTime();
+			GeradorSequencias gerador = new GeradorSequencias(grafo, tamanho_maximo, prefixo);
+			gerador.setTabelas(tabelas);
+			StringBuilder texto = new StringBuilder();
+			Resultado resultado = new Resultado();
+			OutputStream temporario = null;
+			boolean concluido = false;
+			try {
+				while(gerador.hasNext()) {
+					GeradorSequencias.formatar(grafo, gerador.next(), texto);
+					resultado.sequencias = resultado.sequencias + 1;
+					if(texto.length()<TAMANHO_TRECHO && gerador.hasNext()) continue;
+
+					byte[] trecho = texto.toString().getBytes(StandardCharsets.UTF_8);
+					texto.setLength(0);
+					if(temporario==null && em_memoria.addAndGet(trecho.length)>LIMITE_MEMORIA) {
+						em_memoria.addAndGet(-trecho.length);
+						File arquivo = File.createTempFile("sequencias", ".txt");
+						arquivo.deleteOnExit();
+						resultado.partes.add(arquivo);
+						temporario = new BufferedOutputStream(new FileOutputStream(arquivo), 1<<16);
+					}
+					if(temporario!=null) temporario.write(trecho);
+					else {
+						resultado.partes.add(trecho);
+						resultado.bytes = resultado.bytes + trecho.length;
+					}
+				}
+				if(temporario!=null) temporario.close();
+				concluido = true;
+			} catch (IOException e) {
+				throw new UncheckedIOException(e);
+			} finally {
+				if(!concluido) {
+					if(temporario!=null) {
+						try {
+							temporario.close();
+						} catch (IOException ignorada) {
+						}
+					}
+					resultado.descartar();
+				}
+			}
+			long sequencias = resultado.sequencias;
+
+			AtomicLong[] contadores = vazao.computeIfAbsent(Thread.currentThread().getName(), nome -> new AtomicLong[] {new AtomicLong(), new AtomicLong(), new AtomicLong()});
+			contadores[0].addAndGet(sequencias);
+			contadores[1].incrementAndGet();
+			contadores[2].addAndGet(System.nanoTime()-comeco);
+
+			return resultado;
+		}
+	}
+
+	//// sequencias, prefixos e sequencias por segundo de cada thread na ultima execucao
+	public String getRelatorio() {
+
+		StringBuilder relatorio = new StringBuilder();
+		long total = 0;
+		for(Map.Entry<String, AtomicLong[]> thread : new TreeMap<String, AtomicLong[]>(vazao).entrySet()) {
+			long sequencias = thread.getValue()[0].get();
+			long prefixos = thread.getValue()[1].get();
+			double segundos = thread.getValue()[2].get()/1e9;
+			relatorio.append(String.format("%s: %d sequencias, %d prefixos, %.0f sequencias/s%n", thread.getKey(), sequencias, prefixos, segundos>0 ? sequencias/segundos : 0.0));
+			total = total + sequencias;
+		}
+		double segundos = tempo_total/1e9;
+		relatorio.append(String.format("total: %d sequencias em %.3f s (%.0f sequencias/s)%n", total, segundos, segundos>0 ? total/segundos : 0.0));
+		return relatorio.toString();
+	}
+
+	public void setNiveis_divisao(int niveis_divisao) {
+		this.niveis_divisao = niveis_divisao;
+	}
+
+}
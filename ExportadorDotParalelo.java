@@ -0,0 +1,173 @@
+package leitura_interface;
+
+//// exportacao do DOT em paralelo, com saida identica byte a byte a EFG.exportarEFGDot()
+//// os nos sao divididos em faixas com quantidades parecidas de arestas; cada faixa e formatada por uma
+//// thread em um buffer proprio (declaracoes e arestas separadas) e os buffers sao escritos no FileChannel
+//// na ordem das faixas. No maximo 2*threads buffers ficam prontos esperando a escrita.
+//// gravar() devolve o tamanho do texto, antes de uma eventual compressao (caminhos .gz).
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.Channels;
+import java.nio.channels.FileChannel;
+import java.nio.channels.WritableByteChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Paths;
+import java.nio.file.StandardOpenOption;
+import java.util.ArrayList;
+import java.util.LinkedList;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+
+public class ExportadorDotParalelo {
+
+	private GrafoEFG grafo;
+	private int[] inicio_janela;
+	private boolean[] fronteira;
+
+	public ExportadorDotParalelo(GrafoEFG grafo) {
+		this.grafo = grafo;
+
+		// os nos de cada janela sao consecutivos; inicio_janela[j]..inicio_janela[j+1] e a faixa da janela j
+		int janelas = grafo.quantidadeJanelas();
+		inicio_janela = new int[janelas+1];
+		for(int v=0;v<grafo.quantidadeNos();v++) {
+			inicio_janela[grafo.getJanela(v)+1]++;
+		}
+		for(int j=0;j<janelas;j++) inicio_janela[j+1] += inicio_janela[j];
+		fronteira = new boolean[grafo.quantidadeNos()+1];
+		for(int j=0;j<=janelas;j++) fronteira[inicio_janela[j]] = true;
+	}
+
+	public long gravar(String caminho_arquivo, int threads) throws IOException {
+
+		ArrayList<int[]> faixas = dividir(4*threads);
+		ArrayList<Tarefa> tarefas = new ArrayList<Tarefa>();
+		for(int[] faixa : faixas) tarefas.add(new Tarefa(faixa[0], faixa[1], true));
+		for(int[] faixa : faixas) tarefas.add(new Tarefa(faixa[0], faixa[1], false));
+
+		// .gz: a formatacao continua paralela e a compressao acontece na escrita, em ordem
+		WritableByteChannel canal;
+		if(ArquivoSaida.isComprimido(caminho_arquivo)) {
+			canal = Channels.newChannel(ArquivoSaida.abrir(caminho_arquivo));
+		}
+		else {
+			canal = FileChannel.open(Paths.get(caminho_arquivo), StandardOpenOption.CREATE, StandardOpenOption.TRUNCATE_EXISTING, StandardOpenOption.WRITE);
+		}
+		ExecutorService executor = Executors.newFixedThreadPool(threads);
+		long bytes = 0;
+		try {
+			bytes = bytes + escrever(canal, "strict digraph G {"+"\n");
+
+			int janela = 2*threads;
+			LinkedList<Future<ByteBuffer>> em_andamento = new LinkedList<Future<ByteBuffer>>();
+			int proxima = 0;
+			while(proxima<tarefas.size() || !em_andamento.isEmpty()) {
+				while(proxima<tarefas.size() && em_andamento.size()<janela) {
+					em_andamento.add(executor.submit(tarefas.get(proxima)));
+					proxima = proxima + 1;
+				}
+				ByteBuffer buffer = em_andamento.poll().get();
+				bytes = bytes + buffer.remaining();
+				while(buffer.hasRemaining()) canal.write(buffer);
+			}
+
+			bytes = bytes + escrever(canal, "}");
+		} catch (InterruptedException e) {
+			Thread.currentThread().interrupt();
+			throw new IOException(e);
+		} catch (ExecutionException e) {
+			throw new IOException(e.getCause());
+		} finally {
+			executor.shutdownNow();
+			canal.close();
+		}
+		return bytes;
+	}
+
+	private static int escrever(WritableByteChannel canal, String texto) throws IOException {
+		ByteBuffer buffer = ByteBuffer.wrap(texto.getBytes(StandardCharsets.UTF_8));
+		int tamanho = buffer.remaining();
+		while(buffer.hasRemaining()) canal.write(buffer);
+		return tamanho;
+	}
+
+	//// faixas de nos [inicio, fim) com aproximadamente o mesmo numero de nos + arestas
+	private ArrayList<int[]> dividir(int quantidade) {
+
+		int n = grafo.quantidadeNos();
+		long total = n + grafo.quantidadeArestas();
+		long alvo = Math.max(1, total/Math.max(1, quantidade));
+		ArrayList<int[]> faixas = new ArrayList<int[]>();
+		int inicio = 0;
+		long acumulado = 0;
+		for(int v=0;v<n;v++) {
+			acumulado = acumulado + 1 + grafo.grau(v);
+			if(acumulado>=alvo) {
+				faixas.add(new int[] {inicio, v+1});
+				inicio = v+1;
+				acumulado = 0;
+			}
+		}
+		if(inicio<n || faixas.isEmpty()) faixas.add(new int[] {inicio, n});
+		return faixas;
+	}
+
+	private class Tarefa implements Callable<ByteBuffer> {
+
+		private int inicio;
+		private int fim;
+		private boolean declaracoes;
+
+		Tarefa(int inicio, int fim, boolean declaracoes) {
+			this.inicio = inicio;
+			this.fim = fim;
+			this.declaracoes = declaracoes;
+		}
+
+		@Override
+		public ByteBuffer call() {
+			StringBuilder texto = new StringBuilder();
+			if(declaracoes) {
+				formatarDeclaracoes(texto);
+			}
+			else {
+				for(int v=inicio;v<fim;v++) {
+					for(int i=0;i<grafo.grau(v);i++) {
+						texto.append('\t').append(grafo.getNome(v)).append(" -> ").append(grafo.getNome(grafo.vizinho(v, i))).append(";\n");
+					}
+				}
+			}
+			return ByteBuffer.wrap(texto.toString().getBytes(StandardCharsets.UTF_8));
+		}
+
+		// mesmo texto de EFG.declaracoesDot(): com varias janelas, cada uma e um cluster
+		private void formatarDeclaracoes(StringBuilder texto) {
+			boolean varias_janelas = grafo.quantidadeJanelas()>1;
+			for(int v=inicio;v<fim;v++) {
+				if(varias_janelas && fronteira[v]) clusters(v, texto);
+				texto.append(varias_janelas ? "\t\t" : "\t").append(grafo.getNome(v)).append(";\n");
+			}
+			// a ultima faixa fecha a ultima janela (e abre e fecha as janelas vazias do fim)
+			if(varias_janelas && fim==grafo.quantidadeNos()) clusters(fim, texto);
+		}
+
+		// clusters que fecham e abrem na posicao p, em ordem de janela
+		private void clusters(int p, StringBuilder texto) {
+			GraphViz gv = new GraphViz();
+			for(int j=0;j<grafo.quantidadeJanelas();j++) {
+				if(inicio_janela[j]==p) {
+					texto.append('\t').append(gv.start_subgraph(j)).append('\n');
+					texto.append("\t\tlabel=\"").append(grafo.getNomeJanela(j)).append("\";\n");
+				}
+				if(inicio_janela[j+1]==p) {
+					texto.append('\t').append(gv.end_subgraph()).append('\n');
+				}
+			}
+		}
+	}
+
+}
@@ -0,0 +1,142 @@
+package leitura_interface;
+
+//// exportadores em fluxo para ferramentas de analise e bancos de grafos: GraphML, JSON lines e CSV
+//// cada no sai com tipo_no, nome_componente, funcao_acao, linha do .ui, container e janela. Os registros
+//// sao escritos um a um direto do GrafoEFG, sem montar o texto em memoria; caminhos .gz saem comprimidos.
+//// O id de cada no e o indice no GrafoEFG (os nomes se repetem, ex.: varios "completar"); o nome vai como atributo.
+
+import java.io.IOException;
+import java.io.Writer;
+import java.nio.charset.StandardCharsets;
+
+public class ExportadorGrafo {
+
+	private GrafoEFG grafo;
+
+	public ExportadorGrafo(GrafoEFG grafo) {
+		this.grafo = grafo;
+	}
+
+	public void gravarGraphML(String caminho_arquivo) throws IOException {
+
+		Writer saida = ArquivoSaida.abrirTexto(caminho_arquivo, StandardCharsets.UTF_8);
+		try {
+			saida.write("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+			saida.write("<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\">\n");
+			saida.write("  <key id=\"nome\" for=\"node\" attr.name=\"nome\" attr.type=\"string\"/>\n");
+			saida.write("  <key id=\"tipo_no\" for=\"node\" attr.name=\"tipo_no\" attr.type=\"string\"/>\n");
+			saida.write("  <key id=\"nome_componente\" for=\"node\" attr.name=\"nome_componente\" attr.type=\"string\"/>\n");
+			saida.write("  <key id=\"funcao_acao\" for=\"node\" attr.name=\"funcao_acao\" attr.type=\"string\"/>\n");
+			saida.write("  <key id=\"linha\" for=\"node\" attr.name=\"linha\" attr.type=\"int\"/>\n");
+			saida.write("  <key id=\"container\" for=\"node\" attr.name=\"container\" attr.type=\"string\"/>\n");
+			saida.write("  <key id=\"janela\" for=\"node\" attr.name=\"janela\" attr.type=\"string\"/>\n");
+			saida.write("  <graph id=\"EFG\" edgedefault=\"directed\">\n");
+
+			for(int v=0;v<grafo.quantidadeNos();v++) {
+				saida.write("    <node id=\""+v+"\">");
+				saida.write("<data key=\"nome\">"+xml(texto(grafo.getNome(v)))+"</data>");
+				saida.write("<data key=\"tipo_no\">"+xml(texto(grafo.getTipo_no(v)))+"</data>");
+				saida.write("<data key=\"nome_componente\">"+xml(texto(grafo.getTipo(v)))+"</data>");
+				saida.write("<data key=\"funcao_acao\">"+xml(texto(grafo.getFuncao_acao(v)))+"</data>");
+				saida.write("<data key=\"linha\">"+grafo.getLinha_fonte(v)+"</data>");
+				saida.write("<data key=\"container\">"+xml(container(v))+"</data>");
+				saida.write("<data key=\"janela\">"+xml(grafo.getNomeJanela(grafo.getJanela(v)))+"</data>");
+				saida.write("</node>\n");
+			}
+			for(int v=0;v<grafo.quantidadeNos();v++) {
+				for(int i=0;i<grafo.grau(v);i++) {
+					saida.write("    <edge source=\""+v+"\" target=\""+grafo.vizinho(v, i)+"\"/>\n");
+				}
+			}
+
+			saida.write("  </graph>\n");
+			saida.write("</graphml>\n");
+		} finally {
+			saida.close();
+		}
+	}
+
+	//// um objeto JSON por linha: primeiro os nos ("elemento":"no"), depois as arestas ("elemento":"aresta")
+	public void gravarJSONL(String caminho_arquivo) throws IOException {
+
+		Writer saida = ArquivoSaida.abrirTexto(caminho_arquivo, StandardCharsets.UTF_8);
+		try {
+			for(int v=0;v<grafo.quantidadeNos();v++) {
+				saida.write("{\"elemento\":\"no\",\"id\":"+v
+						+",\"nome\":"+json(grafo.getNome(v))
+						+",\"tipo_no\":"+json(grafo.getTipo_no(v))
+						+",\"nome_componente\":"+json(grafo.getTipo(v))
+						+",\"funcao_acao\":"+json(grafo.getFuncao_acao(v))
+						+",\"linha\":"+grafo.getLinha_fonte(v)
+						+",\"container\":"+json(grafo.getContainer(v)<0 ? null : container(v))
+						+",\"janela\":"+json(grafo.getNomeJanela(grafo.getJanela(v)))+"}\n");
+			}
+			for(int v=0;v<grafo.quantidadeNos();v++) {
+				for(int i=0;i<grafo.grau(v);i++) {
+					saida.write("{\"elemento\":\"aresta\",\"origem\":"+v+",\"destino\":"+grafo.vizinho(v, i)+"}\n");
+				}
+			}
+		} finally {
+			saida.close();
+		}
+	}
+
+	//// nos e arestas em dois arquivos CSV com cabecalho
+	public void gravarCSV(String caminho_nos, String caminho_arestas) throws IOException {
+
+		Writer nos = ArquivoSaida.abrirTexto(caminho_nos, StandardCharsets.UTF_8);
+		try {
+			nos.write("id,nome,tipo_no,nome_componente,funcao_acao,linha,container,janela\n");
+			for(int v=0;v<grafo.quantidadeNos();v++) {
+				nos.write(v+","+csv(texto(grafo.getNome(v)))+","+csv(texto(grafo.getTipo_no(v)))+","+csv(texto(grafo.getTipo(v)))+","
+						+csv(texto(grafo.getFuncao_acao(v)))+","+grafo.getLinha_fonte(v)+","+csv(container(v))+","
+						+csv(grafo.getNomeJanela(grafo.getJanela(v)))+"\n");
+			}
+		} finally {
+			nos.close();
+		}
+
+		Writer arestas = ArquivoSaida.abrirTexto(caminho_arestas, StandardCharsets.UTF_8);
+		try {
+			arestas.write("origem,destino\n");
+			for(int v=0;v<grafo.quantidadeNos();v++) {
+				for(int i=0;i<grafo.grau(v);i++) {
+					arestas.write(v+","+grafo.vizinho(v, i)+"\n");
+				}
+			}
+		} finally {
+			arestas.close();
+		}
+	}
+
+	private String container(int v) {
+		return grafo.getContainer(v)<0 ? "" : grafo.getNomeContainer(grafo.getContainer(v));
+	}
+
+	private static String texto(Object valor) {
+		return valor==null ? "" : valor.toString();
+	}
+
+	private static String xml(String texto) {
+		return texto.replace("&", "&amp;").replace("<", "&lt;").replace(">", "&gt;").replace("\"", "&quot;");
+	}
+
+	private static String json(Object valor) {
+		if(valor==null) return "null";
+		String texto = valor.toString();
+		StringBuilder saida = new StringBuilder("\"");
+		for(int i=0;i<texto.length();i++) {
+			char c = texto.charAt(i);
+			if(c=='"' || c=='\\') saida.append('\\').append(c);
+			else if(c<0x20) saida.append(String.format("\\u%04x", (int) c));
+			else saida.append(c);
+		}
+		return saida.append('"').toString();
+	}
+
+	private static String csv(String texto) {
+		if(texto.indexOf(',')<0 && texto.indexOf('"')<0 && texto.indexOf('\n')<0) return texto;
+		return "\""+texto.replace("\"", "\"\"")+"\"";
+	}
+
+}
@@ -0,0 +1,172 @@
+package leitura_interface;
+
+//// alcancabilidade entre todos os pares de nos do EFG
+//// 1. componentes fortemente conexas (Tarjan iterativo): a clique de nos medio vira uma componente so
+//// 2. fecho transitivo no DAG das componentes, com 64 componentes por long: as componentes saem do
+////    Tarjan em ordem topologica invertida, entao cada uma so precisa do OR das sucessoras ja prontas
+
+import java.util.Arrays;
+
+public class FechoTransitivo {
+
+	private GrafoEFG grafo;
+	private int[] componente;
+	private int[] tamanho_componente;
+	private boolean[] ciclica;
+	private int quantidade_componentes;
+	private long[][] alcanca;
+
+	public FechoTransitivo(GrafoEFG grafo) {
+		this.grafo = grafo;
+		condensar();
+		fechar();
+	}
+
+	private void condensar() {
+
+		int n = grafo.quantidadeNos();
+		componente = new int[n];
+		int[] indice = new int[n];
+		int[] menor = new int[n];
+		boolean[] na_pilha = new boolean[n];
+		int[] pilha = new int[n];
+		int topo = 0;
+		int[] chamadas = new int[n];
+		int[] proximo_vizinho = new int[n];
+		int contador = 0;
+		quantidade_componentes = 0;
+		Arrays.fill(indice, -1);
+
+		for(int raiz=0;raiz<n;raiz++) {
+			if(indice[raiz]>=0) continue;
+
+			int profundidade = 0;
+			chamadas[0] = raiz;
+			proximo_vizinho[raiz] = 0;
+			indice[raiz] = contador;
+			menor[raiz] = contador;
+			contador = contador + 1;
+			pilha[topo] = raiz;
+			topo = topo + 1;
+			na_pilha[raiz] = true;
+
+			while(profundidade>=0) {
+				int v = chamadas[profundidade];
+
+				if(proximo_vizinho[v]<grafo.grau(v)) {
+					int u = grafo.vizinho(v, proximo_vizinho[v]);
+					proximo_vizinho[v] = proximo_vizinho[v] + 1;
+					if(indice[u]<0) {
+						indice[u] = contador;
+						menor[u] = contador;
+						contador = contador + 1;
+						pilha[topo] = u;
+						topo = topo + 1;
+						na_pilha[u] = true;
+						proximo_vizinho[u] = 0;
+						profundidade = profundidade + 1;
+						chamadas[profundidade] = u;
+					}
+					else if(na_pilha[u]) {
+						menor[v] = Math.min(menor[v], indice[u]);
+					}
+					continue;
+				}
+
+				// v terminou: fecha a componente se v e a raiz dela
+				if(menor[v]==indice[v]) {
+					int w;
+					do {
+						topo = topo - 1;
+						w = pilha[topo];
+						na_pilha[w] = false;
+						componente[w] = quantidade_componentes;
+					} while(w!=v);
+					quantidade_componentes = quantidade_componentes + 1;
+				}
+				profundidade = profundidade - 1;
+				if(profundidade>=0) {
+					int pai = chamadas[profundidade];
+					menor[pai] = Math.min(menor[pai], menor[v]);
+				}
+			}
+		}
+
+		tamanho_componente = new int[quantidade_componentes];
+		ciclica = new boolean[quantidade_componentes];
+		for(int v=0;v<n;v++) {
+			tamanho_componente[componente[v]] = tamanho_componente[componente[v]] + 1;
+		}
+		for(int v=0;v<n;v++) {
+			if(tamanho_componente[componente[v]]>1) {
+				ciclica[componente[v]] = true;
+				continue;
+			}
+			for(int i=0;i<grafo.grau(v);i++) {
+				if(grafo.vizinho(v, i)==v) ciclica[componente[v]] = true;
+			}
+		}
+	}
+
+	private void fechar() {
+
+		int n = grafo.quantidadeNos();
+		int palavras = (quantidade_componentes+63)/64;
+		alcanca = new long[quantidade_componentes][palavras];
+
+		// nos de cada componente, para percorrer as componentes na ordem em que o Tarjan as fechou
+		int[] inicio = new int[quantidade_componentes+1];
+		for(int v=0;v<n;v++) inicio[componente[v]+1]++;
+		for(int c=0;c<quantidade_componentes;c++) inicio[c+1] += inicio[c];
+		int[] nos = new int[n];
+		int[] posicao = Arrays.copyOf(inicio, quantidade_componentes);
+		for(int v=0;v<n;v++) {
+			nos[posicao[componente[v]]] = v;
+			posicao[componente[v]]++;
+		}
+
+		int[] linha_vista = new int[grafo.quantidadeLinhas()];
+		Arrays.fill(linha_vista, -1);
+		for(int c=0;c<quantidade_componentes;c++) {
+			long[] bits = alcanca[c];
+			bits[c>>>6] |= 1L<<c;
+			for(int i=inicio[c];i<inicio[c+1];i++) {
+				int linha = grafo.getLinha(nos[i]);
+				if(linha_vista[linha]==c) continue;
+				linha_vista[linha] = c;
+				for(int k=grafo.inicioLinha(linha);k<grafo.fimLinha(linha);k++) {
+					int d = componente[grafo.destino(k)];
+					if(d==c || (bits[d>>>6] & (1L<<d))!=0) continue;
+					long[] sucessora = alcanca[d];
+					for(int p=0;p<palavras;p++) {
+						bits[p] |= sucessora[p];
+					}
+				}
+			}
+		}
+	}
+
+	//// existe caminho de a ate b (todo no alcanca a si mesmo)
+	public boolean reachable(int a, int b) {
+		int d = componente[b];
+		return (alcanca[componente[a]][d>>>6] & (1L<<d))!=0;
+	}
+
+	public int getComponente(int v) {
+		return componente[v];
+	}
+
+	public int quantidadeComponentes() {
+		return quantidade_componentes;
+	}
+
+	public int getTamanhoComponente(int c) {
+		return tamanho_componente[c];
+	}
+
+	//// a componente tem um ciclo (mais de um no ou laco no proprio no)
+	public boolean isCiclica(int c) {
+		return ciclica[c];
+	}
+
+}
@@ -0,0 +1,143 @@
+package leitura_interface;
+
+//// gera, sob demanda, as sequencias de eventos (casos de teste) do EFG:
+//// caminhos que comecam em um no de entrada, terminam em um no terminal e tem no maximo
+//// tamanho_maximo eventos. A busca em profundidade guarda apenas o caminho atual e, para
+//// cada nivel, o proximo vizinho a visitar: a memoria e O(tamanho_maximo).
+
+import java.io.IOException;
+import java.io.Writer;
+import java.util.Arrays;
+import java.util.Iterator;
+import java.util.NoSuchElementException;
+
+public class GeradorSequencias implements Iterator<int[]> {
+
+	private GrafoEFG grafo;
+	private int tamanho_maximo;
+	private int[] caminho;
+	private int[] proximo_vizinho;
+	private int profundidade;
+	private int proxima_entrada;
+	private int base;
+	private int[] pendente;
+	private TabelasDistancia tabelas;
+
+	public GeradorSequencias(GrafoEFG grafo, int tamanho_maximo) {
+		this.grafo = grafo;
+		this.tamanho_maximo = tamanho_maximo;
+		caminho = new int[Math.max(tamanho_maximo, 0)];
+		proximo_vizinho = new int[Math.max(tamanho_maximo, 0)];
+		profundidade = 0;
+		proxima_entrada = 0;
+		base = 0;
+	}
+
+	//// apenas as sequencias que comecam pelo prefixo dado (o proprio prefixo, se terminar em um terminal)
+	public GeradorSequencias(GrafoEFG grafo, int tamanho_maximo, int[] prefixo) {
+		this(grafo, tamanho_maximo);
+		base = prefixo.length;
+		if(base==0 || base>tamanho_maximo) {
+			this.tamanho_maximo = 0;
+			return;
+		}
+		System.arraycopy(prefixo, 0, caminho, 0, base);
+		profundidade = base;
+		proximo_vizinho[base-1] = 0;
+		if(grafo.isTerminal(prefixo[base-1])) pendente = Arrays.copyOf(caminho, base);
+	}
+
+	//// com as tabelas, prefixos que nao chegam a um terminal dentro do tamanho maximo sao descartados em O(1)
+	public void setTabelas(TabelasDistancia tabelas) {
+		this.tabelas = tabelas;
+	}
+
+	@Override
+	public boolean hasNext() {
+		if(pendente==null) pendente = buscar();
+		return pendente!=null;
+	}
+
+	@Override
+	public int[] next() {
+		if(!hasNext()) throw new NoSuchElementException();
+		int[] sequencia = pendente;
+		pendente = null;
+		return sequencia;
+	}
+
+	private int[] buscar() {
+
+		if(tamanho_maximo<=0) return null;
+
+		while(true) {
+
+			if(base>0 && profundidade<base) return null;
+
+			if(profundidade==0) {
+				while(proxima_entrada<grafo.quantidadeNos() && !grafo.isEntrada(proxima_entrada)) {
+					proxima_entrada = proxima_entrada + 1;
+				}
+				if(proxima_entrada>=grafo.quantidadeNos()) return null;
+
+				int entrada = proxima_entrada;
+				proxima_entrada = proxima_entrada + 1;
+				if(tabelas!=null && !tabelas.podeTerminar(entrada, 1, tamanho_maximo)) continue;
+				if(empilhar(entrada)) return Arrays.copyOf(caminho, profundidade);
+				continue;
+			}
+
+			int topo = caminho[profundidade-1];
+			// a sequencia acaba no terminal; sem espaco ou sem vizinhos, volta um nivel
+			if(grafo.isTerminal(topo) || profundidade==tamanho_maximo || proximo_vizinho[profundidade-1]>=grafo.grau(topo)) {
+				profundidade = profundidade - 1;
+				continue;
+			}
+
+			int vizinho = grafo.vizinho(topo, proximo_vizinho[profundidade-1]);
+			proximo_vizinho[profundidade-1] = proximo_vizinho[profundidade-1] + 1;
+			if(tabelas!=null && !tabelas.podeTerminar(vizinho, profundidade+1, tamanho_maximo)) continue;
+			if(empilhar(vizinho)) return Arrays.copyOf(caminho, profundidade);
+		}
+	}
+
+	// empilha o no e diz se o caminho atual e uma sequencia completa
+	private boolean empilhar(int no) {
+		caminho[profundidade] = no;
+		proximo_vizinho[profundidade] = 0;
+		profundidade = profundidade + 1;
+		return grafo.isTerminal(no);
+	}
+
+	//// escreve cada sequencia em uma linha, a medida que e gerada; devolve quantas foram escritas
+	public long gravar(Writer saida) throws IOException {
+		long quantidade = 0;
+		StringBuilder linha = new StringBuilder();
+		while(hasNext()) {
+			linha.setLength(0);
+			formatar(grafo, next(), linha);
+			saida.write(linha.toString());
+			quantidade = quantidade + 1;
+		}
+		saida.flush();
+		return quantidade;
+	}
+
+	public static void formatar(GrafoEFG grafo, int[] sequencia, StringBuilder saida) {
+		for(int i=0;i<sequencia.length;i++) {
+			if(i>0) saida.append(", ");
+			saida.append(grafo.getNome(sequencia[i]));
+		}
+		saida.append("\n");
+	}
+
+	public long gravar(String caminho_arquivo) throws IOException {
+		Writer saida = ArquivoSaida.abrirTexto(caminho_arquivo);
+		try {
+			return gravar(saida);
+		} finally {
+			saida.close();
+		}
+	}
+
+}
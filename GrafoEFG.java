@@ -0,0 +1,533 @@
+package leitura_interface;
+
+//// representacao compacta (somente leitura) do EFG de uma ou mais janelas
+//// nos numerados de 0 a n-1; nos com a mesma lista de saida (ex.: a clique dos nos medio
+//// de um container) compartilham uma unica linha de adjacencia
+//// nomes e funcoes ficam como ids da TabelaSimbolos; o texto so e buscado em getNome/getFuncao_acao
+//// as linhas de adjacencia (inicio/destinos) ficam num VetorInteiros: no heap por padrao, ou fora dele
+//// (memoria direta ou arquivo mapeado) com setArmazenamentoArestas, para EFGs da aplicacao inteira
+
+import java.io.DataOutputStream;
+import java.io.File;
+import java.io.IOException;
+import java.io.UncheckedIOException;
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.IdentityHashMap;
+import java.util.LinkedHashMap;
+import java.util.LinkedList;
+import java.util.List;
+
+public class GrafoEFG {
+
+	private int[] nomes;
+	private nome_componente[] tipos;
+	private tipo_no[] tipos_no;
+	private int[] funcoes;
+	private int[] linhas_fonte;
+	private int[] container;
+	private String[] nomes_containers;
+	private boolean[] containers_visiveis;
+	private int[] janela;
+	private String[] nomes_janelas;
+	private int[] entradas_janelas;
+	private int[] linha;
+	private VetorInteiros inicio;
+	private VetorInteiros destinos;
+	private int[] inicio_dialogos;
+	private String[] dialogos;
+	private TabelaSimbolos simbolos = TabelaSimbolos.getInstance();
+
+	private static armazenamento_arestas armazenamento = armazenamento_arestas.heap;
+	private static File pasta_arestas = null;
+
+	//// onde os grafos criados a partir de agora guardam as arestas; pasta so vale para o modo mapeado
+	public static void setArmazenamentoArestas(armazenamento_arestas modo, File pasta) {
+		armazenamento = modo;
+		pasta_arestas = pasta;
+	}
+
+	public static armazenamento_arestas getArmazenamentoArestas() {
+		return armazenamento;
+	}
+
+	//// se o armazenamento pedido nao pode ser criado, avisa numa linha propria e usa o heap;
+	//// o modo efetivo do grafo fica em getArmazenamento()
+	private static VetorInteiros novoVetor() {
+		try {
+			return VetorInteiros.criar(armazenamento, pasta_arestas);
+		} catch (IOException e) {
+			System.err.printf("Erro na abertura do arquivo: %s.\n Classe: GrafoEFG metodo: novoVetor()\n"
+					+ " Arestas no heap em vez de %s.\n", e.getMessage(), armazenamento);
+			return VetorInteiros.noHeap();
+		}
+	}
+
+	//// libera o armazenamento das arestas (fecha e apaga o arquivo no modo mapeado); o grafo nao pode mais ser usado
+	public void fechar() throws IOException {
+		inicio.fechar();
+		destinos.fechar();
+	}
+
+	public GrafoEFG(List<Window> janelas) {
+
+		boolean varias_janelas = janelas.size()>1;
+		IdentityHashMap<Container, Integer> indices_containers = new IdentityHashMap<Container, Integer>();
+		int n = 0;
+		ArrayList<String> lista_containers = new ArrayList<String>();
+		ArrayList<Boolean> lista_visiveis = new ArrayList<Boolean>();
+
+		nomes_janelas = new String[janelas.size()];
+		int[] bases = new int[janelas.size()];
+		int j = 0;
+		for(Window jan : janelas) {
+			nomes_janelas[j] = jan.getNome();
+			for(Container c : jan.getContainers()) {
+				indices_containers.put(c, lista_containers.size());
+				lista_containers.add(c.getNome());
+				lista_visiveis.add(c.isVisivelInicialmente());
+			}
+			bases[j] = n;
+			n = n + jan.getArmazem().quantidade();
+			j = j + 1;
+		}
+		nomes_containers = lista_containers.toArray(new String[0]);
+		containers_visiveis = new boolean[nomes_containers.length];
+		for(int c=0;c<containers_visiveis.length;c++) {
+			containers_visiveis[c] = lista_visiveis.get(c);
+		}
+
+		nomes = new int[n];
+		tipos = new nome_componente[n];
+		tipos_no = new tipo_no[n];
+		funcoes = new int[n];
+		linhas_fonte = new int[n];
+		container = new int[n];
+		janela = new int[n];
+		linha = new int[n];
+		inicio_dialogos = new int[n+1];
+
+		HashMap<Linha, Integer> linhas = new HashMap<Linha, Integer>();
+		ArrayList<String> lista_dialogos = new ArrayList<String>();
+		inicio = novoVetor();
+		destinos = novoVetor();
+
+		int v = 0;
+		j = 0;
+		for(Window jan : janelas) {
+			// varredura linear das colunas do armazem; o no s da janela e o no base+s do grafo
+			ArmazemComponentes armazem = jan.getArmazem();
+			int base = bases[j];
+			HashMap<Integer, Integer> linhas_caudas = new HashMap<Integer, Integer>();
+			for(int s=0;s<armazem.quantidade();s++) {
+				nomes[v] = varias_janelas ? armazem.getId_qualificado(s, String.valueOf(jan.getNome())) : armazem.getId_nome(s);
+				tipos[v] = armazem.getTipo(s);
+				tipos_no[v] = armazem.getTipo_no(s);
+				funcoes[v] = armazem.getId_funcao(s);
+				linhas_fonte[v] = armazem.getLinha_fonte(s);
+				container[v] = armazem.getContainer(s)==null ? -1 : indices_containers.get(armazem.getContainer(s));
+				janela[v] = j;
+
+				// a linha so e escrita em destinos se ainda nao existe; os nos que usam a mesma cauda
+				// do armazem sem saidas proprias (a clique dos medio) nem precisam ser comparados
+				int cauda = armazem.grauProprio(s)==0 ? armazem.getCauda(s) : -1;
+				Integer existente = cauda<0 ? null : linhas_caudas.get(cauda);
+				if(existente==null) {
+					LinhaArmazem chave = new LinhaArmazem(jan, armazem, s, base);
+					existente = linhas.get(chave);
+					if(existente==null) {
+						int k = destinos.tamanho();
+						for(int i=0;i<chave.tamanho;i++) {
+							adicionar(destinos, chave.valor(i));
+						}
+						existente = inicio.tamanho();
+						linhas.put(new LinhaDestinos(destinos, k, chave.tamanho, chave.hash), existente);
+						adicionar(inicio, k);
+					}
+					if(cauda>=0) linhas_caudas.put(cauda, existente);
+				}
+				linha[v] = existente;
+
+				inicio_dialogos[v] = lista_dialogos.size();
+				lista_dialogos.addAll(armazem.getDialogos(s));
+				v = v + 1;
+			}
+			j = j + 1;
+		}
+		inicio_dialogos[n] = lista_dialogos.size();
+		dialogos = lista_dialogos.toArray(new String[0]);
+
+		adicionar(inicio, destinos.tamanho());
+
+		entradas_janelas = new int[janelas.size()];
+		j = 0;
+		for(Window jan : janelas) {
+			Componente entrada = jan.getRaiz().getEntrada();
+			entradas_janelas[j] = entrada==null ? -1 : bases[j] + entrada.getIndice();
+			j = j + 1;
+		}
+	}
+
+	//// le um grafo gravado por gravar(); os dados podem vir de um arquivo mapeado em memoria
+	public GrafoEFG(ByteBuffer dados) {
+
+		String[] tabela = new String[dados.getInt()];
+		for(int i=0;i<tabela.length;i++) {
+			byte[] texto = new byte[dados.getInt()];
+			dados.get(texto);
+			tabela[i] = new String(texto, StandardCharsets.UTF_8);
+		}
+
+		int n = dados.getInt();
+		nomes = new int[n];
+		tipos = new nome_componente[n];
+		tipos_no = new tipo_no[n];
+		funcoes = new int[n];
+		linhas_fonte = new int[n];
+		container = new int[n];
+		janela = new int[n];
+		linha = new int[n];
+		for(int v=0;v<n;v++) {
+			nomes[v] = simbolos.id(texto(tabela, dados.getInt()));
+			byte tipo = dados.get();
+			tipos[v] = tipo<0 ? null : nome_componente.values()[tipo];
+			byte tipo_do_no = dados.get();
+			tipos_no[v] = tipo_do_no<0 ? null : tipo_no.values()[tipo_do_no];
+			funcoes[v] = simbolos.id(texto(tabela, dados.getInt()));
+			linhas_fonte[v] = dados.getInt();
+			container[v] = dados.getInt();
+			janela[v] = dados.getInt();
+			linha[v] = dados.getInt();
+		}
+
+		nomes_containers = new String[dados.getInt()];
+		containers_visiveis = new boolean[nomes_containers.length];
+		for(int c=0;c<nomes_containers.length;c++) {
+			nomes_containers[c] = texto(tabela, dados.getInt());
+			containers_visiveis[c] = dados.get()!=0;
+		}
+		nomes_janelas = new String[dados.getInt()];
+		entradas_janelas = new int[nomes_janelas.length];
+		for(int j=0;j<nomes_janelas.length;j++) {
+			nomes_janelas[j] = texto(tabela, dados.getInt());
+			entradas_janelas[j] = dados.getInt();
+		}
+
+		inicio = lerVetor(dados);
+		destinos = lerVetor(dados);
+		inicio_dialogos = lerInteiros(dados);
+		dialogos = new String[dados.getInt()];
+		for(int i=0;i<dialogos.length;i++) {
+			dialogos[i] = texto(tabela, dados.getInt());
+		}
+	}
+
+	public void gravar(DataOutputStream saida) throws IOException {
+
+		LinkedHashMap<String, Integer> tabela = new LinkedHashMap<String, Integer>();
+		for(int nome : nomes) indice(tabela, simbolos.nome(nome));
+		for(int funcao : funcoes) indice(tabela, simbolos.nome(funcao));
+		for(String nome : nomes_containers) indice(tabela, nome);
+		for(String nome : nomes_janelas) indice(tabela, nome);
+		for(String dialogo : dialogos) indice(tabela, dialogo);
+
+		saida.writeInt(tabela.size());
+		for(String texto : tabela.keySet()) {
+			byte[] bytes = texto.getBytes(StandardCharsets.UTF_8);
+			saida.writeInt(bytes.length);
+			saida.write(bytes);
+		}
+
+		saida.writeInt(nomes.length);
+		for(int v=0;v<nomes.length;v++) {
+			saida.writeInt(indice(tabela, simbolos.nome(nomes[v])));
+			saida.writeByte(tipos[v]==null ? -1 : tipos[v].ordinal());
+			saida.writeByte(tipos_no[v]==null ? -1 : tipos_no[v].ordinal());
+			saida.writeInt(indice(tabela, simbolos.nome(funcoes[v])));
+			saida.writeInt(linhas_fonte[v]);
+			saida.writeInt(container[v]);
+			saida.writeInt(janela[v]);
+			saida.writeInt(linha[v]);
+		}
+
+		saida.writeInt(nomes_containers.length);
+		for(int c=0;c<nomes_containers.length;c++) {
+			saida.writeInt(indice(tabela, nomes_containers[c]));
+			saida.writeByte(containers_visiveis[c] ? 1 : 0);
+		}
+		saida.writeInt(nomes_janelas.length);
+		for(int j=0;j<nomes_janelas.length;j++) {
+			saida.writeInt(indice(tabela, nomes_janelas[j]));
+			saida.writeInt(entradas_janelas[j]);
+		}
+
+		gravarInteiros(saida, inicio);
+		gravarInteiros(saida, destinos);
+		gravarInteiros(saida, inicio_dialogos);
+		saida.writeInt(dialogos.length);
+		for(String dialogo : dialogos) {
+			saida.writeInt(indice(tabela, dialogo));
+		}
+	}
+
+	private static int indice(LinkedHashMap<String, Integer> tabela, String texto) {
+		if(texto==null) return -1;
+		Integer indice = tabela.get(texto);
+		if(indice==null) {
+			indice = tabela.size();
+			tabela.put(texto, indice);
+		}
+		return indice;
+	}
+
+	private static String texto(String[] tabela, int indice) {
+		return indice<0 ? null : tabela[indice];
+	}
+
+	private static void gravarInteiros(DataOutputStream saida, int[] valores) throws IOException {
+		saida.writeInt(valores.length);
+		for(int valor : valores) {
+			saida.writeInt(valor);
+		}
+	}
+
+	private static void gravarInteiros(DataOutputStream saida, VetorInteiros valores) throws IOException {
+		saida.writeInt(valores.tamanho());
+		for(int i=0;i<valores.tamanho();i++) {
+			saida.writeInt(valores.get(i));
+		}
+	}
+
+	//// fora do heap, as arestas de um fragmento mapeado sao lidas no proprio mapeamento, sem copia
+	private static VetorInteiros lerVetor(ByteBuffer dados) {
+		if(armazenamento==armazenamento_arestas.heap || !dados.isDirect()) return VetorInteiros.de(lerInteiros(dados));
+		int quantidade = dados.getInt();
+		VetorInteiros valores = VetorInteiros.sobre(dados, quantidade);
+		dados.position(dados.position()+4*quantidade);
+		return valores;
+	}
+
+	private static void adicionar(VetorInteiros vetor, int valor) {
+		try {
+			vetor.adicionar(valor);
+		} catch (IOException e) {
+			throw new UncheckedIOException(e);
+		}
+	}
+
+	private static int[] lerInteiros(ByteBuffer dados) {
+		int[] valores = new int[dados.getInt()];
+		dados.asIntBuffer().get(valores);
+		dados.position(dados.position()+4*valores.length);
+		return valores;
+	}
+
+	public int quantidadeNos() {
+		return nomes.length;
+	}
+
+	public long quantidadeArestas() {
+		long total = 0;
+		for(int v=0;v<nomes.length;v++) {
+			total = total + grau(v);
+		}
+		return total;
+	}
+
+	public int grau(int v) {
+		return inicio.get(linha[v]+1) - inicio.get(linha[v]);
+	}
+
+	public int vizinho(int v, int i) {
+		return destinos.get(inicio.get(linha[v])+i);
+	}
+
+	//// linhas de adjacencia compartilhadas
+	public int getLinha(int v) {
+		return linha[v];
+	}
+
+	public int quantidadeLinhas() {
+		return inicio.tamanho()-1;
+	}
+
+	public int inicioLinha(int r) {
+		return inicio.get(r);
+	}
+
+	public int fimLinha(int r) {
+		return inicio.get(r+1);
+	}
+
+	public int quantidadeDestinos() {
+		return destinos.tamanho();
+	}
+
+	public int destino(int k) {
+		return destinos.get(k);
+	}
+
+	//// heap, direto ou mapeado (um grafo lido de fragmento mapeado fica como mapeado); pode ser heap
+	//// mesmo com outro modo em setArmazenamentoArestas, se o armazenamento pedido nao pode ser criado
+	public armazenamento_arestas getArmazenamento() {
+		return destinos.getModo();
+	}
+
+	public String getNome(int v) {
+		return simbolos.nome(nomes[v]);
+	}
+
+	public int getId_nome(int v) {
+		return nomes[v];
+	}
+
+	public nome_componente getTipo(int v) {
+		return tipos[v];
+	}
+
+	public tipo_no getTipo_no(int v) {
+		return tipos_no[v];
+	}
+
+	public String getFuncao_acao(int v) {
+		return simbolos.nome(funcoes[v]);
+	}
+
+	public int getId_funcao(int v) {
+		return funcoes[v];
+	}
+
+	//// linha do .ui de onde o no veio, 0 para os nos criados pelo tradutor
+	public int getLinha_fonte(int v) {
+		return linhas_fonte[v];
+	}
+
+	public int getContainer(int v) {
+		return container[v];
+	}
+
+	public int quantidadeContainers() {
+		return nomes_containers.length;
+	}
+
+	public String getNomeContainer(int c) {
+		return nomes_containers[c];
+	}
+
+	//// eventos disponiveis quando a janela abre: tudo que nao e r_value nos containers visiveis
+	public boolean isEntrada(int v) {
+		if(tipos_no[v]==tipo_no.r_value) return false;
+		return container[v]<0 || containers_visiveis[container[v]];
+	}
+
+	public boolean isTerminal(int v) {
+		return tipos_no[v]==tipo_no.terminal;
+	}
+
+	public int getJanela(int v) {
+		return janela[v];
+	}
+
+	public int quantidadeJanelas() {
+		return nomes_janelas.length;
+	}
+
+	public String getNomeJanela(int j) {
+		return nomes_janelas[j];
+	}
+
+	public int getEntradaJanela(int j) {
+		return entradas_janelas[j];
+	}
+
+	public int quantidadeDialogos(int v) {
+		return inicio_dialogos[v+1] - inicio_dialogos[v];
+	}
+
+	public String getDialogo(int v, int i) {
+		return dialogos[inicio_dialogos[v]+i];
+	}
+
+	public LinkedList<Integer> getTerminais() {
+		LinkedList<Integer> terminais = new LinkedList<Integer>();
+		for(int v=0;v<nomes.length;v++) {
+			if(tipos_no[v]==tipo_no.terminal) terminais.add(v);
+		}
+		return terminais;
+	}
+
+	// lista de destinos comparada pelo conteudo: um trecho ja gravado em destinos, ou a saida
+	// de um no do armazem ainda nao gravada (para procurar a linha antes de escrever)
+	private static abstract class Linha {
+
+		protected int tamanho;
+		protected int hash;
+
+		abstract int valor(int k);
+
+		@Override
+		public int hashCode() {
+			return hash;
+		}
+
+		@Override
+		public boolean equals(Object objeto) {
+			if(!(objeto instanceof Linha)) return false;
+			Linha outra = (Linha) objeto;
+			if(outra.tamanho!=tamanho || outra.hash!=hash) return false;
+			for(int k=0;k<tamanho;k++) {
+				if(valor(k)!=outra.valor(k)) return false;
+			}
+			return true;
+		}
+	}
+
+	// trecho [inicio, inicio+tamanho) de destinos
+	private static class LinhaDestinos extends Linha {
+
+		private VetorInteiros destinos;
+		private int inicio;
+
+		LinhaDestinos(VetorInteiros destinos, int inicio, int tamanho, int hash) {
+			this.destinos = destinos;
+			this.inicio = inicio;
+			this.tamanho = tamanho;
+			this.hash = hash;
+		}
+
+		@Override
+		int valor(int k) {
+			return destinos.get(inicio+k);
+		}
+	}
+
+	// saida do no s do armazem, com os indices ja somados a base da janela
+	private class LinhaArmazem extends Linha {
+
+		private ArmazemComponentes armazem;
+		private int s;
+		private int base;
+
+		LinhaArmazem(Window jan, ArmazemComponentes armazem, int s, int base) {
+			this.armazem = armazem;
+			this.s = s;
+			this.base = base;
+			this.tamanho = armazem.grau(s);
+			int h = 1;
+			for(int k=0;k<tamanho;k++) {
+				int d = armazem.destino(s, k);
+				if(d<0) throw new IllegalStateException("aresta para componente fora da janela "+jan.getNome()+": "+simbolos.nome(armazem.getId_nome(s)));
+				h = 31*h + base + d;
+			}
+			this.hash = h;
+		}
+
+		@Override
+		int valor(int k) {
+			return base + armazem.destino(s, k);
+		}
+	}
+
+}
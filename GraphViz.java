@@ -32,8 +32,12 @@ import java.io.File;
 import java.io.FileInputStream;
 import java.io.FileOutputStream;
 import java.io.FileWriter;
+import java.io.InputStream;
 import java.io.InputStreamReader;
+import java.io.OutputStream;
+import java.util.ArrayList;
 import java.util.Properties;
+import java.util.zip.GZIPInputStream;
 
 
 public class GraphViz
@@ -110,6 +114,30 @@ public class GraphViz
         return this.dpiSizes[this.currentDpiPos];
     }
 
+    /**
+     * Sets the image size to the largest available dpi not above the given value.
+     */
+    public void setImageDpi(int dpi) {
+        this.currentDpiPos = 0;
+        while ( this.currentDpiPos < (this.dpiSizes.length - 1) && this.dpiSizes[this.currentDpiPos + 1] <= dpi ) {
+            ++this.currentDpiPos;
+        }
+    }
+
+    /**
+     * Layout engine passed to dot with -K (dot, neato, sfdp, ...).
+     * null keeps the engine of the configured executable.
+     */
+    private String layout = null;
+
+    public void setLayout(String layout) {
+        this.layout = layout;
+    }
+
+    public String getLayout() {
+        return this.layout;
+    }
+
     /**
      * The source of the graph written in dot language.
      */
@@ -221,32 +249,24 @@ public class GraphViz
 
         try {
             img = File.createTempFile("graph_", "."+type, new File(GraphViz.TEMP_DIR));
-            Runtime rt = Runtime.getRuntime();
             
             // patch by Mike Chenault
             
             
             System.out.println("dot.getAbsolutePath() "+dot.getAbsolutePath());
             System.out.println("img.getAbsolutePath() "+img.getAbsolutePath());
-            String[] args = {DOT, "-T"+type, "-Gdpi="+dpiSizes[this.currentDpiPos], dot.getAbsolutePath(), "-o", img.getAbsolutePath()};
+            String[] args = dot_args(type, dot, img);
             
             for(String e : args) {
             	System.out.print(e + " ");
             }
             System.out.println("");
             
-            Process p = rt.exec(args);
+            Process p = start_dot(args);
 
             p.waitFor();
 
-            FileInputStream in = new FileInputStream(img.getAbsolutePath());
-            img_stream = new byte[in.available()];
-            in.read(img_stream);
-            // Close it if we need to
-            if( in != null ) in.close();
-
-            if (img.delete() == false) 
-                System.err.println("Warning: " + img.getAbsolutePath() + " could not be deleted!");
+            img_stream = read_img(img);
         }
         catch (java.io.IOException ioe) {
             System.err.println("Error:    in I/O processing of tempfile in dir " + GraphViz.TEMP_DIR+"\n");
@@ -261,6 +281,100 @@ public class GraphViz
         return img_stream;
     }
 
+    /**
+     * Returns the graph of a DOT file as an image in binary format.
+     * Files ending in .gz are decompressed on the fly and piped into dot's
+     * standard input, so the uncompressed source never touches the disk.
+     * @param path DOT file, optionally gzip compressed.
+     * @param type Type of the output image to be produced, e.g.: gif, dot, fig, pdf, ps, svg, png.
+     * @return A byte array containing the image of the graph.
+     */
+    public byte[] getGraphFromFile(String path, String type)
+    {
+        if (!path.endsWith(".gz")) {
+            return get_img_stream(new File(path), type);
+        }
+
+        byte[] img_stream = null;
+        Process p = null;
+        try {
+            File img = File.createTempFile("graph_", "."+type, new File(GraphViz.TEMP_DIR));
+            p = start_dot(dot_args(type, null, img));
+
+            try (InputStream in = new GZIPInputStream(new FileInputStream(path), 1 << 16);
+                 OutputStream out = p.getOutputStream()) {
+                byte[] buffer = new byte[1 << 16];
+                int read;
+                while ((read = in.read(buffer)) != -1) {
+                    out.write(buffer, 0, read);
+                }
+            }
+
+            p.waitFor();
+            p = null;
+
+            img_stream = read_img(img);
+        }
+        catch (java.io.IOException ioe) {
+            System.err.println("Error:    in I/O processing of " + path + " or in calling external command");
+            ioe.printStackTrace();
+        }
+        catch (java.lang.InterruptedException ie) {
+            System.err.println("Error: the execution of the external program was interrupted");
+            ie.printStackTrace();
+        }
+        finally {
+            // dot still running after a failure (e.g. broken pipe): do not leave it behind
+            if (p != null) p.destroy();
+        }
+
+        return img_stream;
+    }
+
+    /**
+     * Starts dot with its stdout and stderr forwarded to ours, so a chatty dot
+     * can never block on a full pipe while we are feeding its stdin.
+     */
+    private Process start_dot(String[] args) throws java.io.IOException
+    {
+        ProcessBuilder builder = new ProcessBuilder(args);
+        builder.redirectErrorStream(true);
+        builder.redirectOutput(ProcessBuilder.Redirect.INHERIT);
+        return builder.start();
+    }
+
+    /**
+     * Command line for dot; without a source file dot reads the graph from stdin.
+     */
+    private String[] dot_args(String type, File dot, File img)
+    {
+        ArrayList<String> args = new ArrayList<String>();
+        args.add(DOT);
+        if (layout != null) args.add("-K"+layout);
+        args.add("-T"+type);
+        args.add("-Gdpi="+dpiSizes[this.currentDpiPos]);
+        if (dot != null) args.add(dot.getAbsolutePath());
+        args.add("-o");
+        args.add(img.getAbsolutePath());
+        return args.toArray(new String[0]);
+    }
+
+    /**
+     * Reads and deletes the image produced by dot.
+     */
+    private byte[] read_img(File img) throws java.io.IOException
+    {
+        FileInputStream in = new FileInputStream(img.getAbsolutePath());
+        byte[] img_stream = new byte[in.available()];
+        in.read(img_stream);
+        // Close it if we need to
+        if( in != null ) in.close();
+
+        if (img.delete() == false) 
+            System.err.println("Warning: " + img.getAbsolutePath() + " could not be deleted!");
+        return img_stream;
+    }
+
     /**
      * Writes the source of the graph in a file, and returns the written file
      * as a File object.
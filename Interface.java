@@ -3,10 +3,16 @@ package leitura_interface;
 //// essa classe lê xml. arquivos com extensão .ui
 
 import java.io.BufferedReader;
+import java.io.File;
 import java.io.FileReader;
 import java.io.IOException;
+import java.util.HashSet;
 import java.util.LinkedList;
 import java.util.Scanner;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
 import java.util.regex.Pattern;
 
 public class Interface {
@@ -15,6 +21,8 @@ public class Interface {
 	private LinkedList<Window> minhas_janelas;
 	private String caminho_arquivo_interface_ui;
 	private String caminho_arquivo_interface_cpp;
+	private LinkedList<String> arquivos_ui;
+	private LinkedList<String> arquivos_cpp;
 	public static Interface uniqueInstance;
 	
 	
@@ -22,6 +30,8 @@ public class Interface {
 		caminho_arquivo_interface_cpp = "";
 		caminho_arquivo_interface_ui = "";
 		minhas_janelas = new LinkedList<Window>();
+		arquivos_ui = new LinkedList<String>();
+		arquivos_cpp = new LinkedList<String>();
 		biblioteca = Biblioteca.getInstance();
 	}
 	   
@@ -42,68 +52,105 @@ public class Interface {
 	}
 	
 	public void identificar_janelas(){
-		//// cria uma �nica grid
+		//// uma janela por formulario/dialogo do projeto
+		if(arquivos_ui.isEmpty()) {
+			adicionarArquivos(caminho_arquivo_interface_ui, caminho_arquivo_interface_cpp);
+		}
+		// os nomes prefixam os nos no EFG de varias janelas, entao precisam ser unicos
+		HashSet<String> nomes = new HashSet<String>();
+		for(Window janela : minhas_janelas) nomes.add(janela.getNome());
+		for(int i=0;i<arquivos_ui.size();i++) {
 	    	     Window novo = new Window();
-	    	     novo.setCaminho_arquivo_interface(caminho_arquivo_interface_ui, caminho_arquivo_interface_cpp);
-	    		 novo.setNome(pega_nome_variavel("", nome_componente.grid));
+	    	     novo.setCaminho_arquivo_interface(arquivos_ui.get(i), arquivos_cpp.get(i));
+	    		 novo.setNome(nome_unico(arquivos_ui.get(i), i, nomes));
 	    		 novo.setLinha(0);
 	    		 this.add_janela(novo);
+		}
 	  }
-	
 
-	public void identificar_janelas_ver1(){
-		//// identifica todas as grids
-	    
-	    try {
-	     
-	      FileReader arq = new FileReader(caminho_arquivo_interface_ui);
-	      BufferedReader lerArq = new BufferedReader(arq);
-	 
-	      String linha = lerArq.readLine(); 
-	      int num_linha = 0;
-	      
-	      while (linha != null) {
-	    	  
-	    	  num_linha = num_linha+1;
-	    	  
-	    	  if(linha.contains("//")){
-	    		  linha = lerArq.readLine(); // le da segunda ate a ultima linha
-	    		  continue;
-	    	  }
-	    	  
-	    	  // converte tudo para letra minuscula
-	    	  linha = linha.toLowerCase();
-	    	  
-	    	  //if(linha.contains("layout") && !(linha.contains("/"))){
-	    	  if(linha.contains("<class>")){ 
-	    	     Window novo = new Window();
-	    	     novo.setCaminho_arquivo_interface(caminho_arquivo_interface_ui, caminho_arquivo_interface_cpp);
-	    		 novo.setNome(pega_nome_variavel(linha, nome_componente.grid));
-	    		 novo.setLinha(num_linha);
-	    		 this.add_janela(novo);
-	    		 
-	    	 }
-	        
-	         linha = lerArq.readLine(); // le da segunda ate a ultima linha
-	       }
-	 
-	      arq.close();
-	      
-	    } catch (IOException e) {
-	        System.err.printf("Erro na abertura do arquivo: %s.\n Classe: Interface_qt metodo: identificar_janelas()",
-	          e.getMessage());
-	        
-	    }
-	  }
-	
+	//// nome da classe do formulario; sem <class>, o nome do arquivo .ui; repetido, ganha "_<indice>"
+	private static String nome_unico(String caminho_ui, int indice, HashSet<String> usados) {
+		String nome = pega_nome_classe(caminho_ui);
+		if(nome.isEmpty()) {
+			nome = new File(caminho_ui).getName().toLowerCase();
+			if(nome.endsWith(".ui")) nome = nome.substring(0, nome.length()-".ui".length());
+			nome = nome.replaceAll("[^a-z0-9_]", "_");
+		}
+		String unico = nome;
+		int sufixo = indice;
+		while(!usados.add(unico)) {
+			unico = nome+"_"+sufixo;
+			sufixo = sufixo + 1;
+		}
+		return unico;
+	}
+
+	//// registra mais um formulario (.ui) e o codigo (.cpp) que trata os seus slots
+	public void adicionarArquivos(String caminho_ui, String caminho_cpp) {
+		arquivos_ui.add(caminho_ui);
+		arquivos_cpp.add(caminho_cpp);
+	}
+
 	public void lerComponentes() {
 		
 		this.identificar_janelas();
-		for(Window janelas : minhas_janelas) {
-			janelas.ler_interface();
-			janelas.completar();
-			janelas.identificar_ligacoes();
+
+		// cada janela le o seu .ui e o seu .cpp de forma independente
+		ExecutorService executor = Executors.newFixedThreadPool(Runtime.getRuntime().availableProcessors());
+		boolean concluido = false;
+		try {
+			LinkedList<Future<?>> tarefas = new LinkedList<Future<?>>();
+			for(Window janela : minhas_janelas) {
+				tarefas.add(executor.submit(() -> {
+					janela.ler_interface();
+					janela.completar();
+					janela.identificar_ligacoes();
+				}));
+			}
+			aguardar(tarefas);
+			concluido = !Thread.currentThread().isInterrupted();
+		} finally {
+			// em caso de erro ou interrupcao as tarefas restantes sao canceladas: o pool nao segura a JVM
+			if(concluido) executor.shutdown();
+			else executor.shutdownNow();
+		}
+	}
+
+	public static void aguardar(LinkedList<Future<?>> tarefas) {
+		for(Future<?> tarefa : tarefas) {
+			try {
+				tarefa.get();
+			} catch (InterruptedException e) {
+				Thread.currentThread().interrupt();
+				return;
+			} catch (ExecutionException e) {
+				throw new RuntimeException(e.getCause());
+			}
+		}
+	}
+
+	public static String pega_nome_classe(String caminho_ui){
+
+		try {
+			FileReader arq = new FileReader(caminho_ui);
+			BufferedReader lerArq = new BufferedReader(arq);
+
+			String linha = lerArq.readLine();
+			while (linha != null) {
+				linha = linha.toLowerCase();
+				if(linha.contains("<class>")) {
+					arq.close();
+					return linha.replace("<class>", "").replace("</class>", "").trim();
+				}
+				linha = lerArq.readLine();
+			}
+			arq.close();
+
+		} catch (IOException e) {
+			System.err.printf("Erro na abertura do arquivo: %s.\n Classe: Interface_qt metodo: pega_nome_classe()",
+					e.getMessage());
 		}
+		return "";
 	}
 	
 
@@ -0,0 +1,154 @@
+package leitura_interface;
+
+//// leitor do formato de EFGBinario: mapeia o arquivo em memoria e responde as consultas
+//// direto sobre os bytes mapeados, sem criar objetos por no ou por aresta
+
+import java.io.IOException;
+import java.io.RandomAccessFile;
+import java.nio.ByteBuffer;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.charset.StandardCharsets;
+
+public class LeitorEFGBinario {
+
+	private MappedByteBuffer dados;
+	private int nos;
+	private int linhas;
+	private int destinos;
+	private int textos;
+	private int secao_nomes;
+	private int secao_funcoes;
+	private int secao_linhas;
+	private int secao_inicio;
+	private int secao_destinos;
+	private int secao_inicio_textos;
+	private int secao_tipos_no;
+	private int secao_tipos;
+	private int secao_textos;
+
+	public LeitorEFGBinario(String caminho_arquivo) throws IOException {
+
+		RandomAccessFile arq = new RandomAccessFile(caminho_arquivo, "r");
+		try {
+			FileChannel canal = arq.getChannel();
+			long tamanho = canal.size();
+			if(tamanho<EFGBinario.TAMANHO_CABECALHO) {
+				throw new IOException("EFG binario truncado (menor que o cabecalho): "+caminho_arquivo);
+			}
+			// um MappedByteBuffer tem no maximo 2 GB
+			if(tamanho>Integer.MAX_VALUE) {
+				throw new IOException("EFG binario maior que 2 GB nao e suportado: "+caminho_arquivo+" ("+tamanho+" bytes)");
+			}
+			dados = canal.map(FileChannel.MapMode.READ_ONLY, 0, tamanho);
+		} finally {
+			arq.close();
+		}
+
+		if(dados.getInt(0)!=EFGBinario.ASSINATURA) {
+			throw new IOException("arquivo nao e um EFG binario: "+caminho_arquivo);
+		}
+		if(dados.getInt(4)!=EFGBinario.VERSAO) {
+			throw new IOException("versao do EFG binario nao suportada: "+dados.getInt(4));
+		}
+
+		nos = dados.getInt(8);
+		linhas = dados.getInt(12);
+		destinos = dados.getInt(16);
+		textos = dados.getInt(20);
+		int bytes_textos = dados.getInt(24);
+		if(nos<0 || linhas<0 || destinos<0 || textos<0 || bytes_textos<0) {
+			throw new IOException("cabecalho do EFG binario corrompido: "+caminho_arquivo);
+		}
+
+		// as secoes sao calculadas em long e precisam caber no arquivo
+		long posicao = EFGBinario.TAMANHO_CABECALHO;
+		secao_nomes = (int) posicao;
+		posicao = posicao + 4L*nos;
+		secao_funcoes = secao(posicao, caminho_arquivo);
+		posicao = posicao + 4L*nos;
+		secao_linhas = secao(posicao, caminho_arquivo);
+		posicao = posicao + 4L*nos;
+		secao_inicio = secao(posicao, caminho_arquivo);
+		posicao = posicao + 4L*(linhas+1L);
+		secao_destinos = secao(posicao, caminho_arquivo);
+		posicao = posicao + 4L*destinos;
+		secao_inicio_textos = secao(posicao, caminho_arquivo);
+		posicao = posicao + 4L*(textos+1L);
+		secao_tipos_no = secao(posicao, caminho_arquivo);
+		posicao = posicao + nos;
+		secao_tipos = secao(posicao, caminho_arquivo);
+		posicao = posicao + nos;
+		secao_textos = secao(posicao, caminho_arquivo);
+		secao(posicao + bytes_textos, caminho_arquivo);
+	}
+
+	private int secao(long posicao, String caminho_arquivo) throws IOException {
+		if(posicao>dados.capacity()) {
+			throw new IOException("EFG binario truncado: as secoes precisam de "+posicao+" bytes e o arquivo tem "+dados.capacity()+": "+caminho_arquivo);
+		}
+		return (int) posicao;
+	}
+
+	public int quantidadeNos() {
+		return nos;
+	}
+
+	public int quantidadeDestinos() {
+		return destinos;
+	}
+
+	private int inicio(int v) {
+		int linha = dados.getInt(secao_linhas + 4*v);
+		return dados.getInt(secao_inicio + 4*linha);
+	}
+
+	public int grau(int v) {
+		int linha = dados.getInt(secao_linhas + 4*v);
+		return dados.getInt(secao_inicio + 4*(linha+1)) - dados.getInt(secao_inicio + 4*linha);
+	}
+
+	public int vizinho(int v, int i) {
+		return dados.getInt(secao_destinos + 4*(inicio(v)+i));
+	}
+
+	//// copia os vizinhos de v para o vetor dado e devolve quantos foram copiados
+	public int vizinhos(int v, int[] saida) {
+		int grau = Math.min(grau(v), saida.length);
+		int base = secao_destinos + 4*inicio(v);
+		for(int i=0;i<grau;i++) {
+			saida[i] = dados.getInt(base + 4*i);
+		}
+		return grau;
+	}
+
+	public tipo_no getTipo_no(int v) {
+		byte tipo = dados.get(secao_tipos_no + v);
+		return tipo<0 ? null : tipo_no.values()[tipo];
+	}
+
+	public nome_componente getTipo(int v) {
+		byte tipo = dados.get(secao_tipos + v);
+		return tipo<0 ? null : nome_componente.values()[tipo];
+	}
+
+	public String getNome(int v) {
+		return texto(dados.getInt(secao_nomes + 4*v));
+	}
+
+	public String getFuncao_acao(int v) {
+		return texto(dados.getInt(secao_funcoes + 4*v));
+	}
+
+	private String texto(int indice) {
+		if(indice<0) return null;
+		int de = dados.getInt(secao_inicio_textos + 4*indice);
+		int ate = dados.getInt(secao_inicio_textos + 4*(indice+1));
+		byte[] bytes = new byte[ate-de];
+		ByteBuffer copia = dados.duplicate();
+		copia.position(secao_textos + de);
+		copia.get(bytes);
+		return new String(bytes, StandardCharsets.UTF_8);
+	}
+
+}
@@ -39,6 +39,14 @@ public class Main {
 
 
 		teste.setCaminho_arquivo_interface(cpp_path, ui_path);
+		// formularios da linha de comando, em pares <arquivo.ui> <arquivo.cpp>; sem argumentos vale o caso de estudo acima
+		if(args.length%2!=0) {
+			System.err.println("uso: Main [<arquivo.ui> <arquivo.cpp>]...");
+			return;
+		}
+		for(int i=0;i<args.length;i+=2) {
+			teste.adicionarArquivos(args[i], args[i+1]);
+		}
 
 		teste.lerComponentes();
 		EFG efg = EFG.getInstance();
@@ -46,21 +54,58 @@ public class Main {
 		String formato_dot = efg.exportarEFGDot();
 		efg.imprimirArquivo(path_output, formato_dot);
 
-		createDotGraph(formato_dot, (path_graph));
+		GrafoEFG grafo = efg.getGrafo();
+		// a previa so e renderizada quando a politica a escolhe (modos previa e particionado)
+		createDotGraph(formato_dot, (path_graph), grafo);
 	}	
 
 
-	public static void createDotGraph(String dotFormat,String fileName)
+	// motor, dpi e formato escolhidos pelo tamanho do EFG; acima do orcamento renderiza a previa
+	public static void createDotGraph(String dotFormat,String fileName, GrafoEFG grafo)
 	{
 
+		PoliticaRenderizacao politica = new PoliticaRenderizacao(grafo);
+		System.out.println("renderizacao: "+politica.getRelatorio());
+		if(politica.getModo()==modo_renderizacao.nativo) {
+			new DesenhoSVG(grafo).gravar(fileName+"."+politica.getTipo());
+			return;
+		}
+
 		GraphViz gv = new GraphViz(cfgProp, TEMP_DIR);
+		politica.configurar(gv);
 		gv.addln(gv.start_graph());
-		gv.add(dotFormat);
+		if(politica.getModo()==modo_renderizacao.completo) {
+			gv.add(dotFormat);
+		}
+		else {
+			gv.add(new PreviaEFG(grafo, true).exportarDot());
+		}
+		if(politica.getModo()==modo_renderizacao.particionado) {
+			// um svg por container (com o motor e o dpi da politica) e index.html, alem da previa como visao geral
+			politica.getParticionador().gravar(fileName+"_particoes", "svg", Runtime.getRuntime().availableProcessors(), politica);
+		}
 		gv.addln(gv.end_graph());
-		String type = "pdf";
-		gv.decreaseDpi();
-		gv.decreaseDpi();
+		String type = politica.getTipo();
 		File out = new File(fileName+"."+ type); 
+		if(politica.getModo()==modo_renderizacao.completo) {
+			// reaproveita as posicoes da renderizacao anterior, gravadas ao lado da saida
+			CacheLayout cache = new CacheLayout(fileName+".plain");
+			gv.writeGraphToFile( cache.renderizar(gv, grafo, gv.getDotSource(), politica.getMotor(), type), out );
+		}
+		else {
+			gv.writeGraphToFile( gv.getGraph( gv.getDotSource(), type ), out );
+		}
+	}
+
+	// previa avulsa com os nos medio agrupados por container, em fileName_previa.png; createDotGraph ja
+	// renderiza a previa sozinho quando a politica escolhe esse modo
+	public static void createDotPreview(GrafoEFG grafo, String fileName)
+	{
+
+		GraphViz gv = new GraphViz(cfgProp, TEMP_DIR);
+		gv.add(new PreviaEFG(grafo, true).exportarDot());
+		String type = "png";
+		File out = new File(fileName+"_previa."+ type); 
 		gv.writeGraphToFile( gv.getGraph( gv.getDotSource(), type ), out );
 	}
 
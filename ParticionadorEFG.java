@@ -0,0 +1,249 @@
+package leitura_interface;
+
+//// divide o EFG em um arquivo DOT por container (pagina de abas, groupbox, ...) ou por janela
+//// as arestas que cruzam particoes viram nos "stub" tracejados com link para a particao do outro lado;
+//// as particoes sao renderizadas em paralelo e um index.html liga todas. O tempo e a memoria de cada
+//// renderizacao ficam limitados pelo tamanho da maior particao, e nao do EFG inteiro.
+//// Os tamanhos (nos e arestas desenhadas) saem de uma passada de contagem; as listas de arestas que
+//// chegam de outras particoes so sao montadas quando um DOT e exportado.
+
+import java.io.File;
+import java.io.IOException;
+import java.io.Writer;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.HashSet;
+import java.util.LinkedList;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+
+public class ParticionadorEFG {
+
+	private GrafoEFG grafo;
+	private int[] particao;
+	private ArrayList<String> nomes_particoes;
+	private ArrayList<ArrayList<Integer>> nos_particoes;
+	private ArrayList<ArrayList<int[]>> arestas_externas;
+	private long[] arestas_particoes;
+
+	public ParticionadorEFG(GrafoEFG grafo, boolean por_janela) {
+		this.grafo = grafo;
+		particionar(por_janela);
+	}
+
+	private void particionar(boolean por_janela) {
+
+		int n = grafo.quantidadeNos();
+		particao = new int[n];
+		nomes_particoes = new ArrayList<String>();
+		nos_particoes = new ArrayList<ArrayList<Integer>>();
+
+		// por janela, por container, e os nos sem container ficam na particao da sua janela
+		int[] particao_container = new int[grafo.quantidadeContainers()];
+		int[] particao_janela = new int[grafo.quantidadeJanelas()];
+		Arrays.fill(particao_container, -1);
+		Arrays.fill(particao_janela, -1);
+
+		for(int v=0;v<n;v++) {
+			int c = grafo.getContainer(v);
+			if(por_janela || c<0) {
+				int j = grafo.getJanela(v);
+				if(particao_janela[j]<0) particao_janela[j] = novaParticao(grafo.getNomeJanela(j));
+				particao[v] = particao_janela[j];
+			}
+			else {
+				if(particao_container[c]<0) particao_container[c] = novaParticao(grafo.getNomeContainer(c));
+				particao[v] = particao_container[c];
+			}
+			nos_particoes.get(particao[v]).add(v);
+		}
+
+		// arestas desenhadas em cada particao: as que saem dos seus nos (internas ou para stubs)
+		// mais as que chegam de outras particoes
+		arestas_particoes = new long[nomes_particoes.size()];
+		for(int v=0;v<n;v++) {
+			arestas_particoes[particao[v]] = arestas_particoes[particao[v]] + grafo.grau(v);
+			for(int i=0;i<grafo.grau(v);i++) {
+				int u = grafo.vizinho(v, i);
+				if(particao[u]!=particao[v]) arestas_particoes[particao[u]]++;
+			}
+		}
+	}
+
+	// arestas que chegam em cada particao vindas de outra, em uma unica passada no primeiro uso
+	private synchronized ArrayList<ArrayList<int[]>> externas() {
+		if(arestas_externas!=null) return arestas_externas;
+		ArrayList<ArrayList<int[]>> externas = new ArrayList<ArrayList<int[]>>();
+		for(int p=0;p<nomes_particoes.size();p++) externas.add(new ArrayList<int[]>());
+		for(int v=0;v<grafo.quantidadeNos();v++) {
+			for(int i=0;i<grafo.grau(v);i++) {
+				int u = grafo.vizinho(v, i);
+				if(particao[u]!=particao[v]) externas.get(particao[u]).add(new int[] {v, u});
+			}
+		}
+		arestas_externas = externas;
+		return arestas_externas;
+	}
+
+	private int novaParticao(String nome) {
+		nomes_particoes.add(nome);
+		nos_particoes.add(new ArrayList<Integer>());
+		return nomes_particoes.size()-1;
+	}
+
+	public int quantidadeParticoes() {
+		return nomes_particoes.size();
+	}
+
+	public String getNomeParticao(int p) {
+		return nomes_particoes.get(p);
+	}
+
+	public int getMaiorParticao() {
+		int maior = 0;
+		for(ArrayList<Integer> nos : nos_particoes) maior = Math.max(maior, nos.size());
+		return maior;
+	}
+
+	public long getMaiorParticaoArestas() {
+		long maior = 0;
+		for(long arestas : arestas_particoes) maior = Math.max(maior, arestas);
+		return maior;
+	}
+
+	//// toda particao cabe no orcamento de nos e de arestas
+	public boolean cabe(int orcamento_nos, long orcamento_arestas) {
+		return getMaiorParticao()<=orcamento_nos && getMaiorParticaoArestas()<=orcamento_arestas;
+	}
+
+	public int getParticao(int v) {
+		return particao[v];
+	}
+
+	//// DOT da particao p; "tipo" e a extensao dos arquivos renderizados, usada nos links dos stubs
+	public String exportarDot(int p, String tipo) {
+
+		StringBuilder saida = new StringBuilder("strict digraph G {"+"\n");
+		saida.append("\tlabel=\""+rotulo(nomes_particoes.get(p))+"\";"+"\n");
+		for(int v : nos_particoes.get(p)) {
+			saida.append("\t"+grafo.getNome(v)+";"+"\n");
+		}
+
+		HashSet<Integer> stubs = new HashSet<Integer>();
+		StringBuilder arestas = new StringBuilder();
+		for(int v : nos_particoes.get(p)) {
+			for(int i=0;i<grafo.grau(v);i++) {
+				int u = grafo.vizinho(v, i);
+				if(particao[u]==p) {
+					arestas.append("\t"+grafo.getNome(v)+" -> "+grafo.getNome(u)+";"+"\n");
+				}
+				else {
+					if(stubs.add(u)) saida.append(stub(u, tipo));
+					arestas.append("\t"+grafo.getNome(v)+" -> stub_"+grafo.getNome(u)+";"+"\n");
+				}
+			}
+		}
+
+		// arestas que chegam de outras particoes
+		for(int[] aresta : externas().get(p)) {
+			if(stubs.add(aresta[0])) saida.append(stub(aresta[0], tipo));
+			arestas.append("\tstub_"+grafo.getNome(aresta[0])+" -> "+grafo.getNome(aresta[1])+";"+"\n");
+		}
+
+		saida.append(arestas);
+		saida.append("}");
+		return saida.toString();
+	}
+
+	private String stub(int v, String tipo) {
+		return "\tstub_"+grafo.getNome(v)+" [label=\""+rotulo(grafo.getNome(v))+"\\n("+rotulo(nomes_particoes.get(particao[v]))+")\", shape=box, style=dashed, URL=\""+arquivo(particao[v])+"."+tipo+"\"];"+"\n";
+	}
+
+	// texto dentro de aspas no DOT
+	private static String rotulo(String texto) {
+		return String.valueOf(texto).replace("\\", "\\\\").replace("\"", "\\\"");
+	}
+
+	private static String html(String texto) {
+		return String.valueOf(texto).replace("&", "&amp;").replace("<", "&lt;").replace(">", "&gt;").replace("\"", "&quot;");
+	}
+
+	private static String arquivo(int p) {
+		return "particao_"+p;
+	}
+
+	//// grava particao_N.dot e particao_N.<tipo> em pasta, renderizando ate "threads" particoes ao mesmo tempo
+	public LinkedList<Integer> gravar(String pasta, String tipo, int threads) {
+		return gravar(pasta, tipo, threads, null);
+	}
+
+	//// idem, com o motor e o dpi da politica (null: os padroes do GraphViz); devolve as particoes cuja
+	//// renderizacao falhou, que tambem ficam marcadas no index.html (o .dot delas e gravado mesmo assim)
+	public LinkedList<Integer> gravar(final String pasta, final String tipo, int threads, final PoliticaRenderizacao politica) {
+
+		new File(pasta).mkdirs();
+		final boolean[] falhou = new boolean[quantidadeParticoes()];
+		ExecutorService executor = Executors.newFixedThreadPool(threads);
+		boolean concluido = false;
+		try {
+			LinkedList<Future<?>> tarefas = new LinkedList<Future<?>>();
+			for(int p=0;p<quantidadeParticoes();p++) {
+				final int particao_atual = p;
+				tarefas.add(executor.submit(() -> {
+					String dot = exportarDot(particao_atual, tipo);
+					escrever(new File(pasta, arquivo(particao_atual)+".dot"), dot);
+					GraphViz gv = new GraphViz();
+					if(politica!=null) politica.configurar(gv);
+					gv.add(dot);
+					byte[] imagem = gv.getGraph(gv.getDotSource(), tipo);
+					falhou[particao_atual] = imagem==null || imagem.length==0
+							|| gv.writeGraphToFile(imagem, new File(pasta, arquivo(particao_atual)+"."+tipo))<0;
+				}));
+			}
+			Interface.aguardar(tarefas);
+			concluido = !Thread.currentThread().isInterrupted();
+		} finally {
+			if(concluido) executor.shutdown();
+			else executor.shutdownNow();
+		}
+
+		LinkedList<Integer> falhas = new LinkedList<Integer>();
+		for(int p=0;p<falhou.length;p++) {
+			if(falhou[p]) falhas.add(p);
+		}
+		if(!falhas.isEmpty()) {
+			System.err.println("Particoes que nao foram renderizadas: "+falhas.size()+" de "+falhou.length+" (ver "+new File(pasta, "index.html").getPath()+")");
+		}
+		escrever(new File(pasta, "index.html"), indice(tipo, falhou));
+		return falhas;
+	}
+
+	private String indice(String tipo, boolean[] falhou) {
+
+		StringBuilder html = new StringBuilder("<html>\n<head><meta charset=\"utf-8\"><title>EFG</title></head>\n<body>\n<table>\n");
+		html.append("<tr><th>particao</th><th>nos</th><th>arestas</th><th>dot</th></tr>\n");
+		for(int p=0;p<quantidadeParticoes();p++) {
+			long arestas = arestas_particoes[p];
+			String nome = html(nomes_particoes.get(p));
+			String celula = falhou[p] ? nome+" (renderizacao falhou)" : "<a href=\""+arquivo(p)+"."+tipo+"\">"+nome+"</a>";
+			html.append("<tr><td>"+celula+"</td><td>"+nos_particoes.get(p).size()+"</td><td>"+arestas+"</td><td><a href=\""+arquivo(p)+".dot\">dot</a></td></tr>\n");
+		}
+		html.append("</table>\n</body>\n</html>\n");
+		return html.toString();
+	}
+
+	private static void escrever(File arquivo, String conteudo) {
+		try {
+			Writer saida = ArquivoSaida.abrirTexto(arquivo.getPath());
+			try {
+				saida.write(conteudo);
+			} finally {
+				saida.close();
+			}
+		} catch (IOException e) {
+			System.err.printf("Erro na abertura do arquivo: %s.\n Classe: ParticionadorEFG metodo: escrever()", e.getMessage());
+		}
+	}
+
+}
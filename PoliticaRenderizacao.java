@@ -0,0 +1,130 @@
+package leitura_interface;
+
+//// escolhe motor de layout, dpi, formato de saida e modo de renderizacao a partir do tamanho do EFG
+////   ate limite_nativo nos:   desenho em camadas no proprio processo (DesenhoSVG), svg, sem chamar o Graphviz
+////   ate limite_pequeno nos:  dot hierarquico, 78 dpi, pdf (o que createDotGraph sempre usava)
+////   ate limite_medio nos:    dot, ou neato se o grafo for denso (o dot sofre com muitas arestas por no), 70 dpi, pdf
+////   ate o orcamento:         sfdp (multinivel, quase linear), 57 dpi, svg (vetorial, nao cresce com o dpi)
+////   acima do orcamento:      previa com os nos medio agrupados, dot, 96 dpi, png; se toda particao por
+////                            container cabe no orcamento (nos e arestas), tambem um arquivo por container (particionado)
+//// os parametros escolhidos ficam em getRelatorio() para que a renderizacao possa ser reproduzida
+
+public class PoliticaRenderizacao {
+
+	private int limite_nativo = 40;
+	private int limite_pequeno = 150;
+	private int limite_medio = 600;
+	private int orcamento_nos = 3000;
+	private long orcamento_arestas = 30000;
+	private double densidade_neato = 20;
+
+	private GrafoEFG grafo;
+	private int nos;
+	private long arestas;
+	private ParticionadorEFG particionador;
+	private String motor;
+	private int dpi;
+	private String tipo;
+	private modo_renderizacao modo;
+
+	public PoliticaRenderizacao(GrafoEFG grafo) {
+		this.grafo = grafo;
+		this.nos = grafo.quantidadeNos();
+		this.arestas = grafo.quantidadeArestas();
+		escolher();
+	}
+
+	private void escolher() {
+
+		if(nos>orcamento_nos || arestas>orcamento_arestas) {
+			// o particionador so e criado quando o grafo passa do orcamento, e e reaproveitado por getParticionador()
+			if(particionador==null) particionador = new ParticionadorEFG(grafo, false);
+			modo = particionador.cabe(orcamento_nos, orcamento_arestas) ? modo_renderizacao.particionado : modo_renderizacao.previa;
+			motor = "dot";
+			dpi = 96;
+			tipo = "png";
+			return;
+		}
+
+		if(nos<=limite_nativo) {
+			modo = modo_renderizacao.nativo;
+			motor = "camadas";
+			dpi = 96;
+			tipo = "svg";
+			return;
+		}
+
+		modo = modo_renderizacao.completo;
+		if(nos<=limite_pequeno && arestas<=densidade_neato*limite_pequeno) {
+			motor = "dot";
+			dpi = 78;
+			tipo = "pdf";
+		}
+		else if(nos<=limite_medio) {
+			motor = arestas>densidade_neato*nos ? "neato" : "dot";
+			dpi = 70;
+			tipo = "pdf";
+		}
+		else {
+			motor = "sfdp";
+			dpi = 57;
+			tipo = "svg";
+		}
+	}
+
+	//// aplica motor e dpi ao GraphViz
+	public void configurar(GraphViz gv) {
+		gv.setLayout(motor);
+		gv.setImageDpi(dpi);
+	}
+
+	public String getMotor() {
+		return motor;
+	}
+
+	public int getDpi() {
+		return dpi;
+	}
+
+	public String getTipo() {
+		return tipo;
+	}
+
+	public modo_renderizacao getModo() {
+		return modo;
+	}
+
+	//// particionador por container usado na escolha (null enquanto o grafo couber no orcamento)
+	public ParticionadorEFG getParticionador() {
+		return particionador;
+	}
+
+	public String getRelatorio() {
+		String particoes = particionador==null ? "" : " maior particao="+particionador.getMaiorParticao()+" nos/"+particionador.getMaiorParticaoArestas()+" arestas";
+		return "nos="+nos+" arestas="+arestas+particoes+" modo="+modo+" motor="+motor+" dpi="+dpi+" tipo="+tipo
+				+" (orcamento: "+orcamento_nos+" nos, "+orcamento_arestas+" arestas)";
+	}
+
+	public void setLimites(int limite_pequeno, int limite_medio) {
+		this.limite_pequeno = limite_pequeno;
+		this.limite_medio = limite_medio;
+		escolher();
+	}
+
+	public void setLimite_nativo(int limite_nativo) {
+		this.limite_nativo = limite_nativo;
+		escolher();
+	}
+
+	public void setOrcamento(int orcamento_nos, long orcamento_arestas) {
+		this.orcamento_nos = orcamento_nos;
+		this.orcamento_arestas = orcamento_arestas;
+		escolher();
+	}
+
+	public void setDensidade_neato(double densidade_neato) {
+		this.densidade_neato = densidade_neato;
+		escolher();
+	}
+
+}
@@ -0,0 +1,121 @@
+package leitura_interface;
+
+//// versao resumida do EFG para conferencia visual rapida: os nos medio viram um unico super no
+//// (um por container, ou um so para o grafo inteiro); r_value, terminais e viajantes continuam
+//// explicitos. As arestas sao projetadas nos super nos sem repeticao e os lacos de um super no
+//// nele mesmo (a clique de nos medio) sao omitidos, entao o dot sai com poucas dezenas de arestas.
+
+import java.util.Arrays;
+import java.util.HashSet;
+
+public class PreviaEFG {
+
+	private GrafoEFG grafo;
+	private int[] representante;
+	private String[] nomes_super;
+	private int[] tamanho_super;
+
+	public PreviaEFG(GrafoEFG grafo, boolean por_container) {
+		this.grafo = grafo;
+		agrupar(por_container);
+	}
+
+	private void agrupar(boolean por_container) {
+
+		int n = grafo.quantidadeNos();
+		representante = new int[n];
+		Arrays.fill(representante, -1);
+
+		// super no de cada container; a ultima posicao e a dos nos sem container
+		int[] super_do_container = new int[grafo.quantidadeContainers()+1];
+		Arrays.fill(super_do_container, -1);
+		int quantidade = 0;
+		for(int v=0;v<n;v++) {
+			if(grafo.getTipo_no(v)!=tipo_no.medio) continue;
+			int c = por_container && grafo.getContainer(v)>=0 ? grafo.getContainer(v) : grafo.quantidadeContainers();
+			if(super_do_container[c]<0) {
+				super_do_container[c] = quantidade;
+				quantidade = quantidade + 1;
+			}
+			representante[v] = super_do_container[c];
+		}
+
+		nomes_super = new String[quantidade];
+		tamanho_super = new int[quantidade];
+		for(int c=0;c<super_do_container.length;c++) {
+			int s = super_do_container[c];
+			if(s<0) continue;
+			nomes_super[s] = c<grafo.quantidadeContainers() ? grafo.getNomeContainer(c) : "medio";
+		}
+		for(int v=0;v<n;v++) {
+			if(representante[v]>=0) tamanho_super[representante[v]]++;
+		}
+	}
+
+	// nos explicitos ficam em 0..n-1 e os super nos em n..n+s-1
+	private int no(int v) {
+		return representante[v]<0 ? v : grafo.quantidadeNos()+representante[v];
+	}
+
+	private String id(int no) {
+		return no<grafo.quantidadeNos() ? grafo.getNome(no) : "medio_"+(no-grafo.quantidadeNos());
+	}
+
+	public String exportarDot() {
+
+		int n = grafo.quantidadeNos();
+		StringBuilder saida = new StringBuilder("strict digraph G {"+"\n");
+		for(int s=0;s<nomes_super.length;s++) {
+			saida.append("\t"+id(n+s)+" [label=\""+nomes_super[s]+" ("+tamanho_super[s]+" medio)\", shape=box3d];"+"\n");
+		}
+		for(int v=0;v<n;v++) {
+			if(representante[v]<0) saida.append("\t"+grafo.getNome(v)+";"+"\n");
+		}
+
+		// origens (ja projetadas) de cada linha de adjacencia
+		int[] inicio_origens = new int[grafo.quantidadeLinhas()+1];
+		for(int v=0;v<n;v++) inicio_origens[grafo.getLinha(v)+1]++;
+		for(int r=0;r<grafo.quantidadeLinhas();r++) inicio_origens[r+1] += inicio_origens[r];
+		int[] origens = new int[n];
+		int[] posicao = Arrays.copyOf(inicio_origens, grafo.quantidadeLinhas());
+		for(int v=0;v<n;v++) {
+			origens[posicao[grafo.getLinha(v)]] = no(v);
+			posicao[grafo.getLinha(v)]++;
+		}
+
+		int[] visto_origem = new int[n+nomes_super.length];
+		int[] visto_destino = new int[n+nomes_super.length];
+		Arrays.fill(visto_origem, -1);
+		Arrays.fill(visto_destino, -1);
+		int[] destinos = new int[n+nomes_super.length];
+		HashSet<Long> arestas = new HashSet<Long>();
+
+		for(int r=0;r<grafo.quantidadeLinhas();r++) {
+			if(grafo.fimLinha(r)==grafo.inicioLinha(r)) continue;
+
+			int quantidade_destinos = 0;
+			for(int k=grafo.inicioLinha(r);k<grafo.fimLinha(r);k++) {
+				int d = no(grafo.destino(k));
+				if(visto_destino[d]==r) continue;
+				visto_destino[d] = r;
+				destinos[quantidade_destinos] = d;
+				quantidade_destinos = quantidade_destinos + 1;
+			}
+
+			for(int i=inicio_origens[r];i<inicio_origens[r+1];i++) {
+				int o = origens[i];
+				if(visto_origem[o]==r) continue;
+				visto_origem[o] = r;
+				for(int j=0;j<quantidade_destinos;j++) {
+					int d = destinos[j];
+					if(d==o || !arestas.add(((long) o<<32) | d)) continue;
+					saida.append("\t"+id(o)+" -> "+id(d)+";"+"\n");
+				}
+			}
+		}
+
+		saida.append("}");
+		return saida.toString();
+	}
+
+}
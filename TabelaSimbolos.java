@@ -0,0 +1,82 @@
+package leitura_interface;
+
+//// tabela de simbolos da sessao: cada nome de widget, slot, sinal ou no sintetico (r_valid_x, completar...)
+//// vira um inteiro uma unica vez, e os componentes, o GrafoEFG e os exportadores guardam e comparam
+//// so esses inteiros. O texto volta por nome(id) apenas quando precisa ser escrito.
+//// a instancia e criada na carga da classe porque as janelas sao lidas em paralelo.
+//// limpar() comeca uma sessao nova; cada limpeza muda geracao(), para quem guarda ids saber que perderam o valor.
+
+import java.util.Arrays;
+import java.util.concurrent.ConcurrentHashMap;
+
+public class TabelaSimbolos {
+
+	private static final TabelaSimbolos uniqueInstance = new TabelaSimbolos();
+
+	public static final int NENHUM = -1;
+
+	private ConcurrentHashMap<String, Integer> ids;
+	private volatile String[] nomes;
+	private int quantidade;
+	private volatile int geracao;
+
+	private TabelaSimbolos() {
+		ids = new ConcurrentHashMap<String, Integer>();
+		nomes = new String[1024];
+		quantidade = 0;
+	}
+
+	public static TabelaSimbolos getInstance() {
+		return uniqueInstance;
+	}
+
+	//// id do nome, criando um novo se for a primeira vez; null vira NENHUM
+	public int id(String nome) {
+		if(nome==null) return NENHUM;
+		Integer id = ids.get(nome);
+		if(id!=null) return id;
+		synchronized(this) {
+			id = ids.get(nome);
+			if(id!=null) return id;
+			if(quantidade==nomes.length) {
+				nomes = Arrays.copyOf(nomes, 2*nomes.length);
+			}
+			nomes[quantidade] = nome;
+			id = quantidade;
+			quantidade = quantidade + 1;
+			// o nome entra no vetor antes de o id ficar visivel no mapa
+			ids.put(nome, id);
+			return id;
+		}
+	}
+
+	//// id de um nome ja visto, ou NENHUM; nao cria simbolos
+	public int buscar(String nome) {
+		if(nome==null) return NENHUM;
+		Integer id = ids.get(nome);
+		return id==null ? NENHUM : id;
+	}
+
+	public String nome(int id) {
+		return id==NENHUM ? null : nomes[id];
+	}
+
+	public synchronized int quantidade() {
+		return quantidade;
+	}
+
+	//// esquece todos os simbolos (traducoes repetidas na mesma JVM nao acumulam nomes). Os ids ja
+	//// distribuidos deixam de valer: Componentes e GrafoEFGs anteriores nao devem mais ser usados,
+	//// e nenhuma traducao pode estar em andamento
+	public synchronized void limpar() {
+		ids.clear();
+		nomes = new String[1024];
+		quantidade = 0;
+		geracao = geracao + 1;
+	}
+
+	public int geracao() {
+		return geracao;
+	}
+
+}
@@ -0,0 +1,171 @@
+package leitura_interface;
+
+//// tabelas calculadas uma vez por EFG:
+////   distancia_terminal[v]: menor numero de arestas de v ate um terminal (busca em largura invertida
+////                          a partir de todos os terminais), -1 se nenhum terminal e alcancavel
+////   distancia_entrada[v]:  menor numero de arestas de um no de entrada ate v, -1 se v e inalcancavel
+//// as buscas nao atravessam terminais (a sequencia acaba neles) e percorrem cada linha de adjacencia
+//// compartilhada uma unica vez
+
+import java.util.Arrays;
+import java.util.LinkedList;
+
+public class TabelasDistancia {
+
+	private GrafoEFG grafo;
+	private int[] distancia_terminal;
+	private int[] distancia_entrada;
+
+	public TabelasDistancia(GrafoEFG grafo) {
+		this.grafo = grafo;
+		calcularDistanciaTerminal();
+		calcularDistanciaEntrada();
+	}
+
+	private void calcularDistanciaTerminal() {
+
+		int n = grafo.quantidadeNos();
+		int linhas = grafo.quantidadeLinhas();
+
+		// linhas que contem cada no e nos que usam cada linha, em CSR
+		int[] inicio_linhas_do_no = new int[n+1];
+		for(int k=0;k<grafo.quantidadeDestinos();k++) {
+			inicio_linhas_do_no[grafo.destino(k)+1]++;
+		}
+		for(int v=0;v<n;v++) inicio_linhas_do_no[v+1] += inicio_linhas_do_no[v];
+		int[] linhas_do_no = new int[grafo.quantidadeDestinos()];
+		int[] posicao = Arrays.copyOf(inicio_linhas_do_no, n);
+		for(int r=0;r<linhas;r++) {
+			for(int k=grafo.inicioLinha(r);k<grafo.fimLinha(r);k++) {
+				int u = grafo.destino(k);
+				linhas_do_no[posicao[u]] = r;
+				posicao[u]++;
+			}
+		}
+		int[] inicio_nos_da_linha = new int[linhas+1];
+		for(int v=0;v<n;v++) inicio_nos_da_linha[grafo.getLinha(v)+1]++;
+		for(int r=0;r<linhas;r++) inicio_nos_da_linha[r+1] += inicio_nos_da_linha[r];
+		int[] nos_da_linha = new int[n];
+		posicao = Arrays.copyOf(inicio_nos_da_linha, linhas);
+		for(int v=0;v<n;v++) {
+			nos_da_linha[posicao[grafo.getLinha(v)]] = v;
+			posicao[grafo.getLinha(v)]++;
+		}
+
+		distancia_terminal = new int[n];
+		Arrays.fill(distancia_terminal, -1);
+		boolean[] linha_vista = new boolean[linhas];
+		int[] fila = new int[n];
+		int cabeca = 0;
+		int cauda = 0;
+		for(int v=0;v<n;v++) {
+			if(grafo.isTerminal(v)) {
+				distancia_terminal[v] = 0;
+				fila[cauda] = v;
+				cauda = cauda + 1;
+			}
+		}
+
+		while(cabeca<cauda) {
+			int u = fila[cabeca];
+			cabeca = cabeca + 1;
+			for(int i=inicio_linhas_do_no[u];i<inicio_linhas_do_no[u+1];i++) {
+				int r = linhas_do_no[i];
+				if(linha_vista[r]) continue;
+				linha_vista[r] = true;
+				for(int j=inicio_nos_da_linha[r];j<inicio_nos_da_linha[r+1];j++) {
+					int v = nos_da_linha[j];
+					if(distancia_terminal[v]>=0) continue;
+					distancia_terminal[v] = distancia_terminal[u] + 1;
+					fila[cauda] = v;
+					cauda = cauda + 1;
+				}
+			}
+		}
+	}
+
+	private void calcularDistanciaEntrada() {
+
+		int n = grafo.quantidadeNos();
+		distancia_entrada = new int[n];
+		Arrays.fill(distancia_entrada, -1);
+		boolean[] linha_vista = new boolean[grafo.quantidadeLinhas()];
+		int[] fila = new int[n];
+		int cabeca = 0;
+		int cauda = 0;
+		for(int v=0;v<n;v++) {
+			if(grafo.isEntrada(v)) {
+				distancia_entrada[v] = 0;
+				fila[cauda] = v;
+				cauda = cauda + 1;
+			}
+		}
+
+		while(cabeca<cauda) {
+			int v = fila[cabeca];
+			cabeca = cabeca + 1;
+			if(grafo.isTerminal(v)) continue;
+			int r = grafo.getLinha(v);
+			if(linha_vista[r]) continue;
+			linha_vista[r] = true;
+			for(int k=grafo.inicioLinha(r);k<grafo.fimLinha(r);k++) {
+				int u = grafo.destino(k);
+				if(distancia_entrada[u]>=0) continue;
+				distancia_entrada[u] = distancia_entrada[v] + 1;
+				fila[cauda] = u;
+				cauda = cauda + 1;
+			}
+		}
+	}
+
+	public int getDistanciaTerminal(int v) {
+		return distancia_terminal[v];
+	}
+
+	public int getDistanciaEntrada(int v) {
+		return distancia_entrada[v];
+	}
+
+	public boolean isAlcancavel(int v) {
+		return distancia_entrada[v]>=0;
+	}
+
+	//// um prefixo de tamanho "tamanho" que termina em v ainda chega a um terminal com no maximo tamanho_maximo eventos?
+	public boolean podeTerminar(int v, int tamanho, int tamanho_maximo) {
+		return distancia_terminal[v]>=0 && tamanho + distancia_terminal[v] <= tamanho_maximo;
+	}
+
+	public LinkedList<Integer> getInalcancaveis() {
+		LinkedList<Integer> inalcancaveis = new LinkedList<Integer>();
+		for(int v=0;v<distancia_entrada.length;v++) {
+			if(distancia_entrada[v]<0) inalcancaveis.add(v);
+		}
+		return inalcancaveis;
+	}
+
+	//// nos que nao chegam a nenhum terminal
+	public LinkedList<Integer> getSemSaida() {
+		LinkedList<Integer> sem_saida = new LinkedList<Integer>();
+		for(int v=0;v<distancia_terminal.length;v++) {
+			if(distancia_terminal[v]<0) sem_saida.add(v);
+		}
+		return sem_saida;
+	}
+
+	//// acrescenta ao DOT um rotulo externo com as distancias; inalcancaveis em vermelho, sem saida tracejados
+	public String anotarDot(String dot) {
+
+		StringBuilder anotacoes = new StringBuilder();
+		for(int v=0;v<grafo.quantidadeNos();v++) {
+			anotacoes.append("\t"+grafo.getNome(v)+" [xlabel=\"e="+distancia_entrada[v]+" t="+distancia_terminal[v]+"\"");
+			if(distancia_entrada[v]<0) anotacoes.append(", color=red");
+			if(distancia_terminal[v]<0) anotacoes.append(", style=dashed");
+			anotacoes.append("];"+"\n");
+		}
+
+		int fim = dot.lastIndexOf('}');
+		if(fim<0) return dot + anotacoes;
+		return dot.substring(0, fim) + anotacoes + dot.substring(fim);
+	}
+
+}
@@ -0,0 +1,168 @@
+package leitura_interface;
+
+//// vetor de int que cresce por blocos e pode viver no heap, em memoria direta ou num arquivo mapeado
+//// cada bloco tem ate 2^26 inteiros (256 MB), entao o vetor passa do limite de 2 GB de um ByteBuffer;
+//// so o ultimo bloco cresce (dobrando), os anteriores ficam fixos. As leituras sao absolutas,
+//// entao varias threads podem ler ao mesmo tempo; escrever e de uma thread so.
+//// No modo mapeado cada bloco e mapeado inteiro de uma vez (o arquivo fica esparso), entao nao ha
+//// remapeamentos; fechar() fecha o canal e apaga o arquivo temporario.
+
+import java.io.File;
+import java.io.IOException;
+import java.io.RandomAccessFile;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.IntBuffer;
+import java.nio.channels.FileChannel;
+import java.util.Arrays;
+
+public class VetorInteiros {
+
+	private static final int BITS_BLOCO = 26;
+	private static final int TAMANHO_BLOCO = 1<<BITS_BLOCO;
+	private static final int MASCARA = TAMANHO_BLOCO-1;
+
+	private armazenamento_arestas modo;
+	private IntBuffer[] blocos;
+	private int quantidade_blocos;
+	private int tamanho;
+	private boolean somente_leitura;
+	private FileChannel canal;
+	private File arquivo;
+
+	private VetorInteiros(armazenamento_arestas modo) {
+		this.modo = modo;
+		blocos = new IntBuffer[4];
+	}
+
+	//// vetor vazio no modo dado; no modo mapeado o arquivo temporario e criado em pasta (null: pasta temporaria do sistema)
+	public static VetorInteiros criar(armazenamento_arestas modo, File pasta) throws IOException {
+		VetorInteiros vetor = new VetorInteiros(modo);
+		if(modo==armazenamento_arestas.mapeado) {
+			vetor.arquivo = File.createTempFile("arestas", ".bin", pasta);
+			vetor.arquivo.deleteOnExit();
+			vetor.canal = new RandomAccessFile(vetor.arquivo, "rw").getChannel();
+		}
+		return vetor;
+	}
+
+	//// vetor vazio no heap (nao depende de arquivo, serve de alternativa quando o mapeado falha)
+	public static VetorInteiros noHeap() {
+		return new VetorInteiros(armazenamento_arestas.heap);
+	}
+
+	//// vetor no heap com os valores dados; se cabem num bloco, o proprio int[] vira o bloco
+	public static VetorInteiros de(int[] valores) {
+		VetorInteiros vetor = new VetorInteiros(armazenamento_arestas.heap);
+		if(valores.length<=TAMANHO_BLOCO) {
+			vetor.novoBloco(IntBuffer.wrap(valores));
+			vetor.tamanho = valores.length;
+			return vetor;
+		}
+		for(int inicio=0;inicio<valores.length;inicio+=TAMANHO_BLOCO) {
+			int fim = Math.min(valores.length, inicio+TAMANHO_BLOCO);
+			vetor.novoBloco(IntBuffer.wrap(Arrays.copyOfRange(valores, inicio, fim)));
+		}
+		vetor.tamanho = valores.length;
+		return vetor;
+	}
+
+	//// visao somente leitura de quantidade inteiros a partir da posicao atual de dados, sem copiar
+	//// (usado sobre os fragmentos mapeados do ArmazemFragmentos); a posicao de dados nao muda
+	public static VetorInteiros sobre(ByteBuffer dados, int quantidade) {
+		VetorInteiros vetor = new VetorInteiros(dados.isDirect() ? armazenamento_arestas.mapeado : armazenamento_arestas.heap);
+		ByteBuffer copia = dados.duplicate().order(dados.order());
+		for(int inicio=0;inicio<quantidade;inicio+=TAMANHO_BLOCO) {
+			int n = Math.min(quantidade-inicio, TAMANHO_BLOCO);
+			copia.limit(copia.position()+4*n);
+			vetor.novoBloco(copia.slice().order(dados.order()).asIntBuffer());
+			copia.position(copia.limit());
+			copia.limit(copia.capacity());
+		}
+		vetor.tamanho = quantidade;
+		vetor.somente_leitura = true;
+		return vetor;
+	}
+
+	private void novoBloco(IntBuffer bloco) {
+		if(quantidade_blocos==blocos.length) blocos = Arrays.copyOf(blocos, 2*blocos.length);
+		blocos[quantidade_blocos] = bloco;
+		quantidade_blocos = quantidade_blocos + 1;
+	}
+
+	private IntBuffer alocar(int b, int capacidade) throws IOException {
+		switch(modo) {
+		case direto:
+			return ByteBuffer.allocateDirect(4*capacidade).order(ByteOrder.nativeOrder()).asIntBuffer();
+		case mapeado:
+			if(canal==null) throw new IOException("VetorInteiros mapeado ja foi fechado");
+			return canal.map(FileChannel.MapMode.READ_WRITE, 4L*TAMANHO_BLOCO*b, 4L*capacidade).order(ByteOrder.nativeOrder()).asIntBuffer();
+		default:
+			return IntBuffer.allocate(capacidade);
+		}
+	}
+
+	private void reservar(int minimo) throws IOException {
+		int b = quantidade_blocos-1;
+		int capacidade_total = b<0 ? 0 : b*TAMANHO_BLOCO + blocos[b].capacity();
+		while(capacidade_total<minimo) {
+			if(b<0 || blocos[b].capacity()==TAMANHO_BLOCO) {
+				// mapeado: o bloco inteiro de uma vez, para nunca remapear
+				novoBloco(alocar(quantidade_blocos, modo==armazenamento_arestas.mapeado ? TAMANHO_BLOCO : 1024));
+				b = quantidade_blocos-1;
+			} else {
+				// blocos vindos de de(int[]) podem ter qualquer capacidade, ate 0
+				IntBuffer antigo = blocos[b];
+				IntBuffer novo = alocar(b, Math.min(Math.max(2*antigo.capacity(), 1024), TAMANHO_BLOCO));
+				antigo.clear();
+				novo.put(antigo);
+				novo.clear();
+				blocos[b] = novo;
+			}
+			capacidade_total = b*TAMANHO_BLOCO + blocos[b].capacity();
+		}
+	}
+
+	public void adicionar(int valor) throws IOException {
+		if(somente_leitura) throw new UnsupportedOperationException("VetorInteiros somente leitura");
+		reservar(tamanho+1);
+		blocos[tamanho>>>BITS_BLOCO].put(tamanho & MASCARA, valor);
+		tamanho = tamanho + 1;
+	}
+
+	public int get(int i) {
+		return blocos[i>>>BITS_BLOCO].get(i & MASCARA);
+	}
+
+	public void set(int i, int valor) {
+		if(somente_leitura) throw new UnsupportedOperationException("VetorInteiros somente leitura");
+		blocos[i>>>BITS_BLOCO].put(i & MASCARA, valor);
+	}
+
+	public int tamanho() {
+		return tamanho;
+	}
+
+	//// descarta os valores a partir de tamanho (a capacidade ja alocada continua reservada)
+	public void truncar(int tamanho) {
+		if(tamanho<this.tamanho) this.tamanho = tamanho;
+	}
+
+	public armazenamento_arestas getModo() {
+		return modo;
+	}
+
+	//// libera os blocos e, no modo mapeado, fecha o canal e apaga o arquivo; o vetor nao pode mais ser usado
+	//// (o Java 8 nao desfaz um mapeamento explicitamente: a memoria volta quando o GC recolher os blocos)
+	public void fechar() throws IOException {
+		blocos = new IntBuffer[4];
+		quantidade_blocos = 0;
+		tamanho = 0;
+		if(canal!=null) {
+			canal.close();
+			canal = null;
+			if(!arquivo.delete()) arquivo.deleteOnExit();
+		}
+	}
+
+}
@@ -0,0 +1,394 @@
+package leitura_interface;
+
+//// o GrafoEFG visto como um Graph<Integer, Long> do JGraphT, sem copiar nos nem arestas
+//// vertices sao os indices 0..n-1 e a aresta u -> v e o long (u<<32)|v, entao origem e destino saem
+//// da propria aresta. A visao e somente leitura; as arestas repetidas de uma linha aparecem uma vez.
+//// As arestas de entrada usam um indice invertido por linha de adjacencia, criado no primeiro uso.
+
+import java.util.AbstractSet;
+import java.util.BitSet;
+import java.util.Collections;
+import java.util.Iterator;
+import java.util.LinkedHashSet;
+import java.util.NoSuchElementException;
+import java.util.Set;
+import java.util.function.Supplier;
+
+import org.jgrapht.GraphType;
+import org.jgrapht.graph.AbstractGraph;
+import org.jgrapht.graph.DefaultGraphType;
+
+public class VisaoJGraphT extends AbstractGraph<Integer, Long> {
+
+	private static final GraphType TIPO = new DefaultGraphType.Builder().directed().allowSelfLoops(true).allowMultipleEdges(false).weighted(false).modifiable(false).build();
+
+	private GrafoEFG grafo;
+	private BitSet repetidas;
+	private int[] grau_linha;
+	private long quantidade_arestas;
+
+	// indice invertido: linhas que contem cada no e nos que usam cada linha. inicio_linhas_do_no e
+	// volatile e e atribuido por ultimo: quem o le nao nulo enxerga os outros tres vetores ja prontos
+	private volatile int[] inicio_linhas_do_no;
+	private int[] linhas_do_no;
+	private int[] inicio_nos_da_linha;
+	private int[] nos_da_linha;
+
+	public VisaoJGraphT(GrafoEFG grafo) {
+		this.grafo = grafo;
+
+		// marca os destinos repetidos dentro de cada linha
+		repetidas = new BitSet(grafo.quantidadeDestinos());
+		grau_linha = new int[grafo.quantidadeLinhas()];
+		int[] visto = new int[grafo.quantidadeNos()];
+		for(int r=0;r<grafo.quantidadeLinhas();r++) {
+			for(int k=grafo.inicioLinha(r);k<grafo.fimLinha(r);k++) {
+				int d = grafo.destino(k);
+				if(visto[d]==r+1) repetidas.set(k);
+				else {
+					visto[d] = r+1;
+					grau_linha[r]++;
+				}
+			}
+		}
+		for(int v=0;v<grafo.quantidadeNos();v++) {
+			quantidade_arestas = quantidade_arestas + grau_linha[grafo.getLinha(v)];
+		}
+	}
+
+	public static long aresta(int origem, int destino) {
+		return ((long) origem<<32) | (destino & 0xffffffffL);
+	}
+
+	private boolean existe(int v) {
+		return v>=0 && v<grafo.quantidadeNos();
+	}
+
+	private boolean existeAresta(int origem, int destino) {
+		if(!existe(origem) || !existe(destino)) return false;
+		int r = grafo.getLinha(origem);
+		for(int k=grafo.inicioLinha(r);k<grafo.fimLinha(r);k++) {
+			if(grafo.destino(k)==destino) return true;
+		}
+		return false;
+	}
+
+	@Override
+	public Set<Long> getAllEdges(Integer origem, Integer destino) {
+		if(!containsVertex(origem) || !containsVertex(destino)) return null;
+		if(!existeAresta(origem, destino)) return Collections.emptySet();
+		return Collections.singleton(aresta(origem, destino));
+	}
+
+	@Override
+	public Long getEdge(Integer origem, Integer destino) {
+		if(origem==null || destino==null || !existeAresta(origem, destino)) return null;
+		return aresta(origem, destino);
+	}
+
+	public Supplier<Integer> getVertexSupplier() {
+		return null;
+	}
+
+	public Supplier<Long> getEdgeSupplier() {
+		return null;
+	}
+
+	@Override
+	public Long addEdge(Integer origem, Integer destino) {
+		throw new UnsupportedOperationException("VisaoJGraphT e somente leitura");
+	}
+
+	@Override
+	public boolean addEdge(Integer origem, Integer destino, Long aresta) {
+		throw new UnsupportedOperationException("VisaoJGraphT e somente leitura");
+	}
+
+	public Integer addVertex() {
+		throw new UnsupportedOperationException("VisaoJGraphT e somente leitura");
+	}
+
+	@Override
+	public boolean addVertex(Integer v) {
+		throw new UnsupportedOperationException("VisaoJGraphT e somente leitura");
+	}
+
+	@Override
+	public boolean containsEdge(Long aresta) {
+		return aresta!=null && existeAresta(getEdgeSource(aresta), getEdgeTarget(aresta));
+	}
+
+	@Override
+	public boolean containsVertex(Integer v) {
+		return v!=null && existe(v);
+	}
+
+	@Override
+	public Set<Long> edgeSet() {
+		return new AbstractSet<Long>() {
+			@Override
+			public Iterator<Long> iterator() {
+				return new Arestas(0, grafo.quantidadeNos());
+			}
+
+			@Override
+			public int size() {
+				return (int) Math.min(quantidade_arestas, Integer.MAX_VALUE);
+			}
+
+			@Override
+			public boolean contains(Object aresta) {
+				return aresta instanceof Long && containsEdge((Long) aresta);
+			}
+		};
+	}
+
+	@Override
+	public int degreeOf(Integer v) {
+		return inDegreeOf(v) + outDegreeOf(v);
+	}
+
+	@Override
+	public Set<Long> edgesOf(Integer v) {
+		LinkedHashSet<Long> arestas = new LinkedHashSet<Long>(outgoingEdgesOf(v));
+		arestas.addAll(incomingEdgesOf(v));
+		return Collections.unmodifiableSet(arestas);
+	}
+
+	@Override
+	public int inDegreeOf(Integer v) {
+		assertVertexExist(v);
+		indexarEntradas();
+		int grau = 0;
+		for(int i=inicio_linhas_do_no[v];i<inicio_linhas_do_no[v+1];i++) {
+			int r = linhas_do_no[i];
+			grau = grau + inicio_nos_da_linha[r+1] - inicio_nos_da_linha[r];
+		}
+		return grau;
+	}
+
+	@Override
+	public Set<Long> incomingEdgesOf(Integer v) {
+		assertVertexExist(v);
+		indexarEntradas();
+		final int destino = v;
+		return new AbstractSet<Long>() {
+			@Override
+			public Iterator<Long> iterator() {
+				return new Iterator<Long>() {
+					private int i = inicio_linhas_do_no[destino];
+					private int j = i<inicio_linhas_do_no[destino+1] ? inicio_nos_da_linha[linhas_do_no[i]] : 0;
+
+					private void avancar() {
+						while(i<inicio_linhas_do_no[destino+1] && j>=inicio_nos_da_linha[linhas_do_no[i]+1]) {
+							i = i + 1;
+							if(i<inicio_linhas_do_no[destino+1]) j = inicio_nos_da_linha[linhas_do_no[i]];
+						}
+					}
+
+					@Override
+					public boolean hasNext() {
+						avancar();
+						return i<inicio_linhas_do_no[destino+1];
+					}
+
+					@Override
+					public Long next() {
+						if(!hasNext()) throw new NoSuchElementException();
+						int origem = nos_da_linha[j];
+						j = j + 1;
+						return aresta(origem, destino);
+					}
+				};
+			}
+
+			@Override
+			public int size() {
+				return inDegreeOf(destino);
+			}
+		};
+	}
+
+	@Override
+	public int outDegreeOf(Integer v) {
+		assertVertexExist(v);
+		return grau_linha[grafo.getLinha(v)];
+	}
+
+	@Override
+	public Set<Long> outgoingEdgesOf(Integer v) {
+		assertVertexExist(v);
+		final int origem = v;
+		return new AbstractSet<Long>() {
+			@Override
+			public Iterator<Long> iterator() {
+				return new Arestas(origem, origem+1);
+			}
+
+			@Override
+			public int size() {
+				return grau_linha[grafo.getLinha(origem)];
+			}
+		};
+	}
+
+	@Override
+	public Long removeEdge(Integer origem, Integer destino) {
+		throw new UnsupportedOperationException("VisaoJGraphT e somente leitura");
+	}
+
+	@Override
+	public boolean removeEdge(Long aresta) {
+		throw new UnsupportedOperationException("VisaoJGraphT e somente leitura");
+	}
+
+	@Override
+	public boolean removeVertex(Integer v) {
+		throw new UnsupportedOperationException("VisaoJGraphT e somente leitura");
+	}
+
+	@Override
+	public Set<Integer> vertexSet() {
+		return new AbstractSet<Integer>() {
+			@Override
+			public Iterator<Integer> iterator() {
+				return new Iterator<Integer>() {
+					private int v = 0;
+
+					@Override
+					public boolean hasNext() {
+						return v<grafo.quantidadeNos();
+					}
+
+					@Override
+					public Integer next() {
+						if(!hasNext()) throw new NoSuchElementException();
+						v = v + 1;
+						return v - 1;
+					}
+				};
+			}
+
+			@Override
+			public int size() {
+				return grafo.quantidadeNos();
+			}
+
+			@Override
+			public boolean contains(Object v) {
+				return v instanceof Integer && existe((Integer) v);
+			}
+		};
+	}
+
+	@Override
+	public Integer getEdgeSource(Long aresta) {
+		return (int) (aresta>>>32);
+	}
+
+	@Override
+	public Integer getEdgeTarget(Long aresta) {
+		return (int) (aresta & 0xffffffffL);
+	}
+
+	@Override
+	public GraphType getType() {
+		return TIPO;
+	}
+
+	@Override
+	public double getEdgeWeight(Long aresta) {
+		return 1.0;
+	}
+
+	@Override
+	public void setEdgeWeight(Long aresta, double peso) {
+		throw new UnsupportedOperationException("VisaoJGraphT e somente leitura");
+	}
+
+	// arestas de saida dos nos [inicio, fim), pulando os destinos repetidos da linha
+	private class Arestas implements Iterator<Long> {
+
+		private int v;
+		private int fim;
+		private int k;
+
+		Arestas(int inicio, int fim) {
+			this.v = inicio;
+			this.fim = fim;
+			this.k = v<fim ? grafo.inicioLinha(grafo.getLinha(v)) : 0;
+		}
+
+		private void avancar() {
+			while(v<fim) {
+				int r = grafo.getLinha(v);
+				while(k<grafo.fimLinha(r) && repetidas.get(k)) k = k + 1;
+				if(k<grafo.fimLinha(r)) return;
+				v = v + 1;
+				if(v<fim) k = grafo.inicioLinha(grafo.getLinha(v));
+			}
+		}
+
+		@Override
+		public boolean hasNext() {
+			avancar();
+			return v<fim;
+		}
+
+		@Override
+		public Long next() {
+			if(!hasNext()) throw new NoSuchElementException();
+			long resultado = aresta(v, grafo.destino(k));
+			k = k + 1;
+			return resultado;
+		}
+	}
+
+	// sem trava depois do primeiro uso: a leitura do volatile publica o indice
+	private void indexarEntradas() {
+		if(inicio_linhas_do_no!=null) return;
+		synchronized(this) {
+			if(inicio_linhas_do_no==null) construirIndice();
+		}
+	}
+
+	private void construirIndice() {
+
+		int n = grafo.quantidadeNos();
+		int linhas = grafo.quantidadeLinhas();
+
+		// so as ocorrencias nao repetidas: cada linha aparece uma vez para cada destino
+		int[] inicio_linhas = new int[n+1];
+		for(int k=0;k<grafo.quantidadeDestinos();k++) {
+			if(!repetidas.get(k)) inicio_linhas[grafo.destino(k)+1]++;
+		}
+		for(int v=0;v<n;v++) inicio_linhas[v+1] += inicio_linhas[v];
+		int[] linhas_no = new int[inicio_linhas[n]];
+		int[] posicao = new int[n];
+		System.arraycopy(inicio_linhas, 0, posicao, 0, n);
+		for(int r=0;r<linhas;r++) {
+			for(int k=grafo.inicioLinha(r);k<grafo.fimLinha(r);k++) {
+				if(repetidas.get(k)) continue;
+				linhas_no[posicao[grafo.destino(k)]] = r;
+				posicao[grafo.destino(k)]++;
+			}
+		}
+
+		int[] inicio_nos = new int[linhas+1];
+		for(int v=0;v<n;v++) inicio_nos[grafo.getLinha(v)+1]++;
+		for(int r=0;r<linhas;r++) inicio_nos[r+1] += inicio_nos[r];
+		int[] nos_linha = new int[n];
+		posicao = new int[linhas];
+		System.arraycopy(inicio_nos, 0, posicao, 0, linhas);
+		for(int v=0;v<n;v++) {
+			nos_linha[posicao[grafo.getLinha(v)]] = v;
+			posicao[grafo.getLinha(v)]++;
+		}
+
+		linhas_do_no = linhas_no;
+		inicio_nos_da_linha = inicio_nos;
+		nos_da_linha = nos_linha;
+		inicio_linhas_do_no = inicio_linhas;
+	}
+
+}
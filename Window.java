@@ -4,19 +4,41 @@ package leitura_interface;
 import java.io.BufferedReader;
 import java.io.FileReader;
 import java.io.IOException;
+import java.util.ArrayList;
+import java.util.IdentityHashMap;
 import java.util.LinkedList;
+import java.util.List;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
 
 public class Window{
 
 
-	private LinkedList<Componente> componentes;
+	private ArmazemComponentes armazem;
+	private LinkedList<Container> containers;
+	private Container raiz;
+	private Container container_atual;
+	private int linha_atual;
 	private String caminho_arquivo_interface_ui;
 	private String caminho_arquivo_interface_cpp;
 	private String nome;
 	private int posicao_linha;
+	private ArrayList<String> linhas_cpp;
+	private ArrayList<String> indice_connect;
+	// so as formas que abrem um dialogo: new X(...), X::getXxx/information/warning/critical/question/about(...),
+	// declaracao "X dlg(...);" e temporario "X(...).exec()/show()/open()"; chamadas como closedialog( nao contam
+	private static final Pattern INVOCACAO_DIALOGO = Pattern.compile(
+			"\\bnew\\s+(\\w*dialog|qmessagebox)\\b"
+			+"|\\b(\\w*dialog|qmessagebox)\\s*::\\s*(?:get\\w*|information|warning|critical|question|about\\w*)\\s*\\("
+			+"|\\b(\\w*dialog|qmessagebox)\\s+\\w+\\s*[(;{]"
+			+"|\\b(\\w*dialog|qmessagebox)\\s*\\([^()]*\\)\\s*\\.\\s*(?:exec|show|open)\\s*\\(");
 
 	public Window(){
-		componentes = new LinkedList<Componente>();
+		armazem = new ArmazemComponentes();
+		containers = new LinkedList<Container>();
+		raiz = new Container("", "janela", null);
+		containers.add(raiz);
+		container_atual = raiz;
 		posicao_linha = 0;
 	}
 
@@ -26,19 +48,56 @@ public class Window{
 
 	public void setNome(String nome) {
 		this.nome = nome;
+		raiz.setNome(nome);
 	}
 
 	public void add_componente(Componente componente){
-		componentes.add(componente);
+		if(componente.getContainer()==null) componente.setContainer(container_atual);
+		if(componente.getLinha_fonte()==0) componente.setLinha_fonte(linha_atual);
+		armazem.adotar(componente);
+		componente.getContainer().add_componente(componente);
 	}
 
-	public LinkedList<Componente> getComponentes() {
-		return componentes;
+	//// visao somente leitura sobre o armazem da janela, na ordem de add_componente
+	public List<Componente> getComponentes() {
+		return armazem.getComponentes();
 	}
 
+	public ArmazemComponentes getArmazem() {
+		return armazem;
+	}
+
+	//// troca os componentes da janela: um armazem novo adota os componentes dados, na ordem da lista,
+	//// e os containers passam a listar so eles; componente sem container desta janela vai para a raiz
+	public void setComponentes(List<Componente> componentes) {
+		ArmazemComponentes novo = new ArmazemComponentes(componentes.size());
+		for(Componente componente : componentes) {
+			novo.adotar(componente);
+		}
+		armazem = novo;
+		reconstruir_containers();
+	}
+
+	private void reconstruir_containers() {
+		IdentityHashMap<Container, Boolean> desta_janela = new IdentityHashMap<Container, Boolean>();
+		for(Container container : containers) {
+			container.getComponentes().clear();
+			desta_janela.put(container, true);
+		}
+		for(Componente componente : armazem.getComponentes()) {
+			if(componente.getContainer()==null || !desta_janela.containsKey(componente.getContainer())) {
+				componente.setContainer(raiz);
+			}
+			componente.getContainer().add_componente(componente);
+		}
+	}
+
+	public LinkedList<Container> getContainers() {
+		return containers;
+	}
 
-	public void setComponentes(LinkedList<Componente> componentes) {
-		this.componentes = componentes;
+	public Container getRaiz() {
+		return raiz;
 	}
 
 
@@ -70,11 +129,18 @@ public class Window{
 
 			int num_linha = 0;
 			// boolean marcador = false;
+			LinkedList<Container> containers_abertos = new LinkedList<Container>();
 
 			while (linha != null) {
 
+				num_linha = num_linha + 1;
+				linha_atual = num_linha;
 				linha = linha.toLowerCase();
 
+				// componentes desta linha pertencem ao container aberto antes dela
+				container_atual = containers_abertos.isEmpty() ? raiz : containers_abertos.peek();
+				atualizar_containers(linha, containers_abertos);
+
 				if(linha.contains(Biblioteca.getInstance().getButton())){
 					Componente novo = new Componente();
 					String nome = pega_nome_variavel(linha, nome_componente.button);
@@ -243,6 +309,8 @@ public class Window{
 			}
 
 			arq.close();
+			container_atual = raiz;
+			linha_atual = 0;
 
 		} catch (IOException e) {
 			System.err.printf("Erro na abertura do arquivo: %s.\n Classe: Window_qt metodo: ler_interface() ",
@@ -253,9 +321,52 @@ public class Window{
 
 
 
-	
+
+	//// mantem a pilha de widgets abertos no .ui; abas, group boxes e paginas viram containers
+	private void atualizar_containers(String linha, LinkedList<Container> containers_abertos){
+
+		if(linha.contains("</widget>")) {
+			if(!containers_abertos.isEmpty()) containers_abertos.pop();
+			return;
+		}
+		if(!linha.contains("<widget") || linha.contains("/>")) return;
+
+		String classe = pega_classe(linha);
+		Container novo;
+		if(containers_abertos.isEmpty()) {
+			novo = raiz;
+		}
+		else if(eh_container(classe) || containers_abertos.peek().isPaginado()) {
+			novo = new Container(pega_nome_variavel(linha, nome_componente.qgroupbox), classe, containers_abertos.peek());
+			containers.add(novo);
+		}
+		else {
+			novo = containers_abertos.peek();
+		}
+		containers_abertos.push(novo);
+	}
+
+	private boolean eh_container(String classe){
+		return classe.equals(Biblioteca.getInstance().getQGroupBox()) || classe.equals("qtabwidget") || classe.equals("qstackedwidget") || classe.equals("qtoolbox") || classe.equals("qwizardpage");
+	}
+
+	private String pega_classe(String linha){
+
+		String pega_classe = "";
+		for(String palavra : linha.trim().split(" ")){
+			if(palavra.startsWith("class=")){
+				pega_classe = palavra.substring("class=".length());
+				break;
+			}
+		}
+		pega_classe = pega_classe.replace(">", "");
+		pega_classe = pega_classe.replace("\"", "");
+
+		return pega_classe;
+	}
+
 	public void completar(){
-		int a = componentes.size();
+		int a = armazem.quantidade();
 		int quantidade_nos_terminais = 0;
 		// descomentar depois
 		// chamar a função depois de tudo
@@ -304,6 +415,7 @@ public class Window{
 
 		int lala;
 		//sequencia obrigatoria
+		this.ler_codigo();
 		lala = this.identificar_no_terminal();
 		int zeze = this.getComponentes().size();
 
@@ -323,13 +435,63 @@ public class Window{
 		 **/
 
 		this.identificar_no_medio();
+		this.identificar_dialogos();
+	}
+
+	//// nome da classe do dialogo a partir da classe do formulario (proximitymatrixcreatordialogform -> proximitymatrixcreatordialog)
+	public static String nome_dialogo(String classe_formulario){
+		if(classe_formulario.endsWith("form")) {
+			return classe_formulario.substring(0, classe_formulario.length()-"form".length());
+		}
+		return classe_formulario;
+	}
+
+	//// dialogos abertos pelo slot de cada componente (new XDialog, XDialog dlg(this), QFileDialog::..., QMessageBox::...)
+	private void identificar_dialogos(){
+
+		String propria_classe = nome==null ? "" : nome_dialogo(nome);
+
+		for(Componente componente : armazem.getComponentes()) {
+			int abre_colchetes=0;
+			int fecha_colchetes=0;
+			boolean to_na_funcao = false;
+
+			if(componente.getFuncao_acao()==null || componente.getFuncao_acao().equals("")) {
+				continue;
+			}
+
+			for(String linha : linhas_cpp) {
+
+				if(linha.contains("void") && linha.contains(componente.getFuncao_acao())) {
+					if(linha.contains("{")) abre_colchetes = abre_colchetes+1;
+					to_na_funcao = true;
+					continue;  
+				}
+
+				if(to_na_funcao==true) {
+
+					if(linha.contains("{")) abre_colchetes = abre_colchetes + 1;
+					if(linha.contains("}")) fecha_colchetes = fecha_colchetes + 1;
+					if(abre_colchetes-fecha_colchetes==0) break;
+
+					Matcher dialogo = INVOCACAO_DIALOGO.matcher(linha);
+					while(dialogo.find()) {
+						String nome_dialogo = dialogo.group(1);
+						for(int g=2;nome_dialogo==null;g++) nome_dialogo = dialogo.group(g);
+						if(!nome_dialogo.equals(propria_classe) && !componente.getDialogos_invocados().contains(nome_dialogo)) {
+							componente.addDialogo_invocado(nome_dialogo);
+						}
+					}
+				}
+			}
+		}
 	}
 
 
 	private void identificar_no_medio(){
 
 
-		for(Componente componente : componentes) {
+		for(Componente componente : armazem.getComponentes()) {
 			if(componente.getTipo_no()!=tipo_no.terminal && componente.getTipo_no()!=tipo_no.r_value) {
 				componente.setTipo_no(tipo_no.medio);
 			}
@@ -341,12 +503,12 @@ public class Window{
 	private int identificar_no_terminal(){
 
 		int x = 0;
-		for(Componente componente : componentes) {
+		for(Componente componente : armazem.getComponentes()) {
 			int abre_colchetes=0;
 			int fecha_colchetes=0;
 			boolean to_na_funcao = false;
 
-			componente.identificar_acao(caminho_arquivo_interface_cpp);
+			componente.identificar_acao(indice_connect);
 
 			if(componente.getNome_variavel().contains("apply") || componente.getNome_variavel().contains("ok") || componente.getNome_variavel().contains("cancel") || componente.getNome_variavel().contains("close")) {
 				componente.setTipo_no(tipo_no.terminal);
@@ -358,62 +520,63 @@ public class Window{
 			}
 
 
+			for(String linha : linhas_cpp) {
 
-			try {
-
-				FileReader arq = new FileReader(caminho_arquivo_interface_cpp);
-				BufferedReader lerArq = new BufferedReader(arq);
-
-				String linha = lerArq.readLine(); 
-				String pega_nome = "";
-
-				while (linha != null) {
-
-
-					linha = linha.toLowerCase();
-
-					String[] palavras = new String[10];
+				if(linha.contains("void") && linha.contains(componente.getFuncao_acao())) {
+					if(linha.contains("{")) abre_colchetes = abre_colchetes+1;
+					to_na_funcao = true;
+					continue;  
+				}
 
-					if(linha.contains("void") && linha.contains(componente.getFuncao_acao())) {
-						if(linha.contains("{")) abre_colchetes = abre_colchetes+1;
-						to_na_funcao = true;
-						linha = lerArq.readLine();
-						continue;  
+				if(to_na_funcao==true) {
+
+					if(linha.contains("{")) abre_colchetes = abre_colchetes + 1;
+					if(linha.contains("}")) fecha_colchetes = fecha_colchetes + 1;
+					if(abre_colchetes-fecha_colchetes==0) break;
+					if(abre_colchetes>fecha_colchetes) { 
+						if(linha.contains("reject()")) {
+							//System.out.println(linha);
+							componente.setTipo_no(tipo_no.terminal);
+							x = x + 1;
+							break;
+						}
 					}
 
+				}
 
+			}
 
 
+		}   
+		return x;
+	}
 
-					if(to_na_funcao==true) {
-
-						if(linha.contains("{")) abre_colchetes = abre_colchetes + 1;
-						if(linha.contains("}")) fecha_colchetes = fecha_colchetes + 1;
-						if(abre_colchetes-fecha_colchetes==0) break;
-						if(abre_colchetes>fecha_colchetes) { 
-							if(linha.contains("reject()")) {
-								//System.out.println(linha);
-								componente.setTipo_no(tipo_no.terminal);
-								x = x + 1;
-								break;
-							}
-						}
+	//// le o .cpp uma unica vez: linhas em minusculo e indice das linhas com connect
+	private void ler_codigo(){
 
-					}
+		linhas_cpp = new ArrayList<String>();
+		indice_connect = new ArrayList<String>();
 
-					linha = lerArq.readLine();    
+		try {
 
+			FileReader arq = new FileReader(caminho_arquivo_interface_cpp);
+			BufferedReader lerArq = new BufferedReader(arq);
 
-				}	  
-				arq.close();
-			} catch (IOException e) {
-				System.err.printf("Erro na abertura do arquivo: %s.\n Classe: Window_qt metodo: identificar_no_terminal()",
-						e.getMessage());
+			String linha = lerArq.readLine();
+			while (linha != null) {
+				linha = linha.toLowerCase();
+				linhas_cpp.add(linha);
+				if(linha.contains("connect") && !linha.contains("//")) {
+					indice_connect.add(linha);
+				}
+				linha = lerArq.readLine();
 			}
+			arq.close();
 
-
-		}   
-		return x;
+		} catch (IOException e) {
+			System.err.printf("Erro na abertura do arquivo: %s.\n Classe: Window_qt metodo: ler_codigo()",
+					e.getMessage());
+		}
 	}
 
 
@@ -422,7 +585,7 @@ public class Window{
 		System.out.println("Quantidade de componentes: "+ this.getComponentes().size());
 		System.out.println();
 
-		for(Componente componente : componentes) {
+		for(Componente componente : armazem.getComponentes()) {
 
 			System.out.println("\t Nome: "+componente.getNome_variavel());
 			System.out.println("\t Tipo de no: "+componente.getTipo_no());
@@ -434,10 +597,15 @@ public class Window{
 	}
 
 
+	//// algum componente da janela tem este nome? nome null da false, e componentes sem nome nunca
+	//// coincidem (antes, com equals, um componente sem nome dava NullPointerException)
 	public boolean verificar_existencia(String nome){
-		for(Componente componente : componentes){
+		// nome que nunca entrou na tabela de simbolos nao pode ser de nenhum componente
+		int id = TabelaSimbolos.getInstance().buscar(nome);
+		if(id==TabelaSimbolos.NENHUM) return false;
+		for(int i=0;i<armazem.quantidade();i++){
 
-			if(componente.getNome_variavel().equals(nome)){
+			if(armazem.getId_nome(i)==id){
 
 				return true;
 			}
@@ -0,0 +1,13 @@
+package leitura_interface;
+
+
+
+public enum armazenamento_arestas {
+	
+	heap, direto, mapeado;
+	
+	// heap: int[] comuns, limitados pelo -Xmx
+	// direto: ByteBuffer.allocateDirect, fora do heap e fora do alcance do GC
+	// mapeado: arquivo temporario mapeado em memoria; o tamanho fica limitado pelo disco e pelo espaco de enderecamento
+
+}
@@ -0,0 +1,14 @@
+package leitura_interface;
+
+
+
+public enum modo_renderizacao {
+	
+	completo, previa, nativo, particionado;
+	
+	// completo: todos os nos e arestas do EFG
+	// previa: nos medio agrupados por container (PreviaEFG)
+	// nativo: layout em camadas e svg gerados sem o Graphviz (DesenhoSVG)
+	// particionado: previa como visao geral, mais um arquivo por container (ParticionadorEFG)
+
+}
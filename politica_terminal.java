@@ -0,0 +1,12 @@
+package leitura_interface;
+
+
+
+public enum politica_terminal {
+	
+	parar, reiniciar;
+	
+	// parar: o passeio acaba no terminal
+	// reiniciar: o passeio continua a partir de uma nova entrada ate completar o tamanho
+
+}